@@ -0,0 +1,122 @@
+/**
+ * Compares the deduplication sets of deduprdf: tsl::sparse_set (--dedup-set sparse) and dedup::CompactHashSet (--dedup-set compact).
+ *
+ * Usage: dedup-set-benchmark [distinct hashes = 20000000] [duplicate ratio = 0.3] [seed = 42]
+ *
+ * The input is generated deterministically from the seed: uniformly distributed 64-bit hashes (like the XXH3 triple hashes)
+ * plus the given ratio of duplicates, shuffled. The memory of tsl::sparse_set is counted by its allocator,
+ * the one of CompactHashSet by CompactHashSet::memory_usage(). Both count allocated capacity.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <rdf4cpp/rdf/storage/util/tsl/sparse_set.h>
+
+#include <dedup/CompactHashSet.hpp>
+#include <dedup/hash_quad.hpp>
+
+namespace {
+
+    size_t allocated_bytes = 0;
+
+    /**
+     * std::allocator that keeps track of the number of allocated bytes in allocated_bytes.
+     */
+    template<typename T>
+    struct CountingAllocator {
+        using value_type = T;
+
+        CountingAllocator() noexcept = default;
+        template<typename U>
+        CountingAllocator(CountingAllocator<U> const &) noexcept {}
+
+        T *allocate(size_t const n) {
+            allocated_bytes += n * sizeof(T);
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        void deallocate(T *const p, size_t const n) noexcept {
+            allocated_bytes -= n * sizeof(T);
+            std::allocator<T>{}.deallocate(p, n);
+        }
+
+        template<typename U>
+        bool operator==(CountingAllocator<U> const &) const noexcept {
+            return true;
+        }
+    };
+
+    uint64_t splitmix64(uint64_t &state) noexcept {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    std::vector<uint64_t> make_input(size_t const distinct, double const duplicate_ratio, uint64_t const seed) {
+        std::vector<uint64_t> hashes;
+        auto const duplicates = static_cast<size_t>(static_cast<double>(distinct) * duplicate_ratio);
+        hashes.reserve(distinct + duplicates);
+
+        uint64_t state = seed;
+        for (size_t i = 0; i < distinct; ++i) {
+            hashes.push_back(splitmix64(state));
+        }
+        std::mt19937_64 rng{seed};
+        for (size_t i = 0; i < duplicates and distinct > 0; ++i) {
+            hashes.push_back(hashes[std::uniform_int_distribution<size_t>{0, distinct - 1}(rng)]);
+        }
+        std::ranges::shuffle(hashes, rng);
+        return hashes;
+    }
+
+    /**
+     * Inserts all hashes and prints insert time and memory per distinct hash.
+     */
+    template<typename Insert, typename MemoryUsage>
+    void run(std::string_view const name, std::vector<uint64_t> const &hashes, Insert &&insert, MemoryUsage &&memory_usage) {
+        size_t inserted = 0;
+        auto const start = std::chrono::steady_clock::now();
+        for (auto const hash : hashes) {
+            inserted += insert(hash);
+        }
+        std::chrono::duration<double, std::nano> const duration = std::chrono::steady_clock::now() - start;
+
+        fmt::print("{:<12} {:>12} distinct {:>8.2f} B/distinct {:>8.1f} ns/insert\n",
+                   name, inserted, static_cast<double>(memory_usage()) / static_cast<double>(inserted),
+                   duration.count() / static_cast<double>(hashes.size()));
+    }
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    size_t const distinct = argc > 1 ? std::stoull(argv[1]) : 20'000'000;
+    double const duplicate_ratio = argc > 2 ? std::stod(argv[2]) : 0.3;
+    uint64_t const seed = argc > 3 ? std::stoull(argv[3]) : 42;
+
+    auto const hashes = make_input(distinct, duplicate_ratio, seed);
+    fmt::print("{} hashes, {} distinct, seed {}\n", hashes.size(), distinct, seed);
+
+    {
+        rdf4cpp::rdf::storage::util::tsl::sparse_set<uint64_t,
+                                                      rdf4cpp::rdftools::dedup::uint64_fast_hash,
+                                                      std::equal_to<uint64_t>,
+                                                      CountingAllocator<uint64_t>>
+                set;
+        run("sparse", hashes, [&set](uint64_t const hash) { return set.insert(hash).second; }, [] { return allocated_bytes; });
+    }
+    {
+        rdf4cpp::rdftools::dedup::CompactHashSet set;
+        run("compact", hashes, [&set](uint64_t const hash) { return set.insert(hash); }, [&set] { return set.memory_usage(); });
+    }
+    return EXIT_SUCCESS;
+}
@@ -1,64 +1,79 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <ranges>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
-#include <xxh3.h>
 #include <cxxopts.hpp>
 #include <fmt/format.h>
 
 #include <rdf4cpp/rdf/version.hpp>
 #include <rdf4cpp/rdf/storage/util/tsl/sparse_set.h>
-#include <rdf4cpp/rdf/storage/util/robin-hood-hashing/robin_hood_hash.hpp>
 
 #include <spdlog/logger.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/spdlog.h>
 
+#include "dedup/CompactHashSet.hpp"
+#include "dedup/WindowedHashSet.hpp"
+#include "dedup/hash_quad.hpp"
+#include "dictionary/DictionaryWriter.hpp"
+#include "io/LineTrackingStreambuf.hpp"
+#include "io/UringStreambuf.hpp"
+#include "parser/ErrorReporter.hpp"
 #include "parser/IStreamQuadIterator.hpp"
+#include "writer/TurtleWriter.hpp"
 #include "rdftools_version.hpp"
 
-/**
- * Hash algorithm with good performance in hashtables
- */
-using uint64_fast_hash = rdf4cpp::rdf::storage::util::robin_hood::hash<uint64_t>;
+using rdf4cpp::rdftools::dedup::hash_quad;
+using rdf4cpp::rdftools::dedup::uint64_fast_hash;
 
 /**
- * Hash the triple part of an rdf4cpp Quad.
- * @note Hashing happens based on rdf4cpp node handles. rdf4cpp canonized most literals before assigning an handle.
- * This deduplicates, e.g: "1.0"^^xsd:decimal and "1"^^xsd:decimal
- * @param quad the quad containing the triple part
- * @return an hash
- */
-auto hash_quad(rdf4cpp::rdftools::parser::StringQuad const &quad) -> uint64_t {
-    std::array<uint64_t, 4> hashes;
-    for (size_t i = 0UL; i < 4UL; ++i) {
-        auto const val = quad[i].view();
-        hashes[i] = XXH3_64bits(val.begin(), val.size());
-    }
-    return XXH3_64bits(hashes.begin(), sizeof(decltype(hashes)));
-};
-
-/**
- * Destructor for std::istream holding either a std::ifstream or std::cin. std::cin is not deleted.
+ * Destructor for std::istream holding either an owned stream (std::ifstream, io::UringIStream) or std::cin. std::cin is not deleted.
  */
 auto istream_destructor = [](std::istream *is_ptr) {
     if (is_ptr and is_ptr != &std::cin) {
-        static_cast<std::ifstream *>(is_ptr)->close();
         delete is_ptr;
     }
 };
 
 /**
- * Destructor for std::ostream holding either a std::ofstream or std::cin. std::cout is not deleted.
+ * Destructor for std::ostream holding either an owned stream (std::ofstream, io::UringOStream) or std::cout. std::cout is not deleted.
  */
 auto ostream_destructor = [](std::ostream *os_ptr) {
     if (os_ptr and os_ptr != &std::cout) {
-        static_cast<std::ofstream *>(os_ptr)->close();
         delete os_ptr;
     }
 };
 
+/**
+ * Creates a stream that reads (Stream = std::istream) or writes (Stream = std::ostream) fd asynchronously via io_uring.
+ * @param fd file descriptor; ownership is only taken if the stream is created
+ * @return the stream or nullptr if io_uring is not available. The caller falls back to regular streams in that case.
+ */
+template<typename Stream>
+auto make_uring_stream([[maybe_unused]] int fd, [[maybe_unused]] bool owns_fd) -> Stream * {
+#ifdef RDFTOOLS_WITH_IO_URING
+    using namespace rdf4cpp::rdftools::io;
+    using UringStream = std::conditional_t<std::is_same_v<Stream, std::istream>, UringIStream, UringOStream>;
+    try {
+        return new UringStream{fd, owns_fd};
+    } catch (std::runtime_error const &e) {
+        spdlog::warn("{}. Falling back to blocking I/O.", e.what());
+        return nullptr;
+    }
+#else
+    spdlog::warn("Built without io_uring support (cmake -DWITH_IO_URING=ON). Falling back to blocking I/O.");
+    return nullptr;
+#endif
+}
+
 int main(int argc, char *argv[]) {
     static constexpr auto tool_name = "deduprdf";
     /*
@@ -79,6 +94,37 @@ int main(int argc, char *argv[]) {
                  cxxopts::value<size_t>())
                 ("o,output", "(optional) file to write result to. The file will be overwritten.",
                  cxxopts::value<std::string>())
+                ("F,output-format", "(optional) format of the result: ntriple (default), turtle or dictionary. "
+                                    "turtle abbreviates IRIs with the prefixes of the input and of frequent namespaces and groups triples by subject. "
+                                    "dictionary writes a sorted, front-coded term dictionary to <output>.dict and fixed-width ID triples to <output>.ids. "
+                                    "It requires --output.",
+                 cxxopts::value<std::string>()->default_value("ntriple"))
+                ("dictionary-memory", "(optional) For output format dictionary: bytes of distinct terms that are held in memory. "
+                                      "Beyond that, sorted runs of terms are spilled next to the output and merged at the end.",
+                 cxxopts::value<size_t>()->default_value(std::to_string(rdf4cpp::rdftools::dictionary::DictionaryWriter::default_memory_limit)))
+                ("prefix-learning", "(optional) For output format turtle: number of leading triples that are held back to learn frequent namespaces. "
+                                    "0 uses only the prefixes of the input.",
+                 cxxopts::value<size_t>()->default_value("10000"))
+                ("dedup-set", "(optional) set used for deduplication: sparse (default) or compact. "
+                              "compact stores the triple hashes in compressed sorted runs. It needs about 6-7 bytes per distinct triple, "
+                              "but inserts are several times slower. Use it only if the default set does not fit into memory.",
+                 cxxopts::value<std::string>()->default_value("sparse"))
+                ("window", "(optional) Deduplicate only within a sliding window of the n most recent distinct triples. "
+                           "Memory stays constant, so this suits unbounded input streams. "
+                           "Input from a pipe, terminal or socket is read without read-ahead and the output is flushed whenever the tool waits for it, "
+                           "so each triple is passed on as soon as it has arrived. Requires output format ntriple.",
+                 cxxopts::value<size_t>())
+                ("window-bytes", "(optional) Like --window, but with the largest window that fits into the given number of bytes of memory.",
+                 cxxopts::value<size_t>())
+                ("io-uring", "(optional) Read input and write output asynchronously via io_uring (Linux only). "
+                             "Falls back to blocking I/O if io_uring is not available.")
+                ("max-error-reports", "(optional) Log only the first n parsing errors of each type individually. "
+                                      "Further errors are counted and summarized periodically.",
+                 cxxopts::value<uint64_t>())
+                ("error-summary-interval", "(optional) Seconds between progress summaries with the number of parsed triples and parsing errors.",
+                 cxxopts::value<uint64_t>()->default_value("10"))
+                ("quarantine", "(optional) file to write input lines with parsing errors to. The file will be overwritten.",
+                 cxxopts::value<std::string>())
                 ("v,version", "Version info.")
                 ("h,help", "Print this help page.");
     }
@@ -92,6 +138,38 @@ int main(int argc, char *argv[]) {
     }
     auto const limit = (parsed_args.count("limit")) ? parsed_args["limit"].as<size_t>()
                                                     : std::numeric_limits<size_t>::max();
+    auto const output_format = parsed_args["output-format"].as<std::string>();
+    if (output_format != "ntriple" and output_format != "turtle" and output_format != "dictionary") {
+        std::cerr << "Unknown output format " << output_format << ". Use either ntriple, turtle or dictionary." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    bool const dictionary_output = output_format == "dictionary";
+    bool const use_io_uring = parsed_args.count("io-uring") > 0;
+    auto const dedup_set = parsed_args["dedup-set"].as<std::string>();
+    if (dedup_set != "sparse" and dedup_set != "compact") {
+        std::cerr << "Unknown deduplication set " << dedup_set << ". Use either sparse or compact." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    bool const windowed = parsed_args["window"].count() or parsed_args["window-bytes"].count();
+    if (windowed) {
+        if (parsed_args["window"].count() and parsed_args["window-bytes"].count()) {
+            std::cerr << "Specify either '--window' or '--window-bytes'." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (dedup_set != "sparse") {
+            std::cerr << "'--window' and '--window-bytes' cannot be combined with '--dedup-set " << dedup_set << "'." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (output_format != "ntriple") {
+            // turtle holds triples back to learn prefixes and to group them by subject, which defeats prompt output
+            std::cerr << "'--window' and '--window-bytes' require output format ntriple." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (dictionary_output and not parsed_args["output"].count()) {
+        std::cerr << "Output format dictionary requires an output file via '--output'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
 
     /*
      * Initialize logger
@@ -116,6 +194,14 @@ int main(int argc, char *argv[]) {
                 std::cerr << file_path << " does not exist.";
                 exit(EXIT_FAILURE);
             }
+            if (use_io_uring) {
+                if (int const fd = ::open(file_path.c_str(), O_RDONLY); fd >= 0) {
+                    if (auto *uring_in = make_uring_stream<std::istream>(fd, true); uring_in != nullptr) {
+                        return std::unique_ptr<std::istream, decltype(istream_destructor)>{uring_in, istream_destructor};
+                    }
+                    ::close(fd);
+                }
+            }
             auto ifs = std::unique_ptr<std::ifstream, decltype(istream_destructor)>{new std::ifstream{file_path},
                                                                                     istream_destructor};
             if (not ifs->is_open()) {
@@ -124,6 +210,11 @@ int main(int argc, char *argv[]) {
             }
             return ifs;
         } else if (not bool(isatty(fileno(stdin)))) { // only works on POSIX right now
+            if (use_io_uring) {
+                if (auto *uring_in = make_uring_stream<std::istream>(STDIN_FILENO, false); uring_in != nullptr) {
+                    return std::unique_ptr<std::istream, decltype(istream_destructor)>{uring_in, istream_destructor};
+                }
+            }
             return std::unique_ptr<std::istream, decltype(istream_destructor)>{&std::cin, istream_destructor};
         } else {
             std::cerr << "Specify either an input file via '--file' or pipe input in.";
@@ -131,15 +222,38 @@ int main(int argc, char *argv[]) {
         }
     }();
 
+    /*
+     * Input that is not a regular file (a pipe, a terminal or a socket) may arrive slowly. In window mode, it is read
+     * without read-ahead, so that each triple is passed on as soon as it has arrived. Regular files are read in pages.
+     */
+    bool const live_input = windowed and [&]() {
+        struct stat st {};
+        if (parsed_args["file"].count()) {
+            return ::stat(parsed_args["file"].as<std::string>().c_str(), &st) == 0 and not S_ISREG(st.st_mode);
+        }
+        return ::fstat(STDIN_FILENO, &st) == 0 and not S_ISREG(st.st_mode);
+    }();
+
     /*
      * Select output to file or pipe
      */
     auto out = [&]() -> std::unique_ptr<std::ostream, decltype(ostream_destructor)> {
 
-        if (parsed_args["output"].count()) {
+        if (dictionary_output) {
+            // the dictionary writer manages its output files itself
+            return std::unique_ptr<std::ostream, decltype(ostream_destructor)>{nullptr, ostream_destructor};
+        } else if (parsed_args["output"].count()) {
             namespace fs = std::filesystem;
             auto const file_path = fs::path(parsed_args["output"].as<std::string>());
             // make sure that the file can be opened
+            if (use_io_uring) {
+                if (int const fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644); fd >= 0) {
+                    if (auto *uring_out = make_uring_stream<std::ostream>(fd, true); uring_out != nullptr) {
+                        return std::unique_ptr<std::ostream, decltype(ostream_destructor)>{uring_out, ostream_destructor};
+                    }
+                    ::close(fd);
+                }
+            }
 
             auto ofs = std::unique_ptr<std::ofstream, decltype(ostream_destructor)>{
                     new std::ofstream{file_path, std::ios::binary}, ostream_destructor};
@@ -149,44 +263,184 @@ int main(int argc, char *argv[]) {
             }
             return ofs;
         } else {
+            if (use_io_uring) {
+                if (auto *uring_out = make_uring_stream<std::ostream>(STDOUT_FILENO, false); uring_out != nullptr) {
+                    return std::unique_ptr<std::ostream, decltype(ostream_destructor)>{uring_out, ostream_destructor};
+                }
+            }
             return std::unique_ptr<std::ostream, decltype(ostream_destructor)>{&std::cout, ostream_destructor};
         }
     }();
 
-    // terminate when the limit is reached
+    auto dictionary_writer = [&]() -> std::unique_ptr<rdf4cpp::rdftools::dictionary::DictionaryWriter> {
+        if (not dictionary_output) {
+            return nullptr;
+        }
+        try {
+            return std::make_unique<rdf4cpp::rdftools::dictionary::DictionaryWriter>(parsed_args["output"].as<std::string>(),
+                                                                                      rdf4cpp::rdftools::dictionary::default_block_size,
+                                                                                      parsed_args["dictionary-memory"].as<size_t>());
+        } catch (std::runtime_error const &e) {
+            std::cerr << e.what() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }();
+
+    auto turtle_writer = [&]() -> std::optional<rdf4cpp::rdftools::writer::TurtleWriter> {
+        if (output_format != "turtle") {
+            return std::nullopt;
+        }
+        rdf4cpp::rdftools::writer::TurtleWriter::Options turtle_options;
+        turtle_options.learning_triples = parsed_args["prefix-learning"].as<size_t>();
+        return std::optional<rdf4cpp::rdftools::writer::TurtleWriter>{std::in_place, *out, turtle_options};
+    }();
+    // prefixes of the input that were handed to the turtle writer
+    size_t declared_prefixes = 0;
+
+    // stop when the limit is reached
     size_t count = 0UL;
-    auto terminate_at_limit = [&count, &limit] {
+    auto limit_reached = [&count, &limit] {
         if (++count > limit) {
-            (void) std::cout.flush();
             spdlog::info("Limit of {} triples reached.", limit);
-            spdlog::info("Shutdown successful.");
-            exit(EXIT_SUCCESS);
+            return true;
         }
+        return false;
     };
 
-    // hashmap for deduplication
-    rdf4cpp::rdf::storage::util::tsl::sparse_set<uint64_t, uint64_fast_hash> deduplication;
-    for (rdf4cpp::rdftools::parser::IStreamQuadIterator qit{*in};
-         qit != rdf4cpp::rdftools::parser::IStreamQuadIterator{}; ++qit) {
-        if (qit->has_value()) {
-            auto const &quad = qit->value();
-            auto const hash = hash_quad(quad);
-            auto &&[_, inserted] = deduplication.insert(hash);
-            if (inserted) {
-                terminate_at_limit();
-                (*out) << fmt::format("{} {} {} .\n",
-                                      static_cast<std::string>(quad[1]),
-                                      static_cast<std::string>(quad[2]),
-                                      static_cast<std::string>(quad[3]));
+    /*
+     * Set up error reporting. Lines for the quarantine file are looked up in the recently read input.
+     */
+    std::optional<rdf4cpp::rdftools::io::LineTrackingStreambuf> recent_lines;
+    std::optional<std::istream> tracked_in;
+    if (parsed_args["quarantine"].count()) {
+        recent_lines.emplace(in->rdbuf(), rdf4cpp::rdftools::io::LineTrackingStreambuf::default_chunk_size, not live_input);
+        tracked_in.emplace(&*recent_lines);
+    }
+    if (live_input) {
+        // flush the output before the input is read (possibly blocking), so that downstream consumers get results promptly
+        in->tie(out.get());
+        if (tracked_in) {
+            tracked_in->tie(out.get());
+        }
+    }
+    auto error_reporter = [&]() -> rdf4cpp::rdftools::parser::ErrorReporter {
+        rdf4cpp::rdftools::parser::ErrorReporter::Options error_options;
+        if (parsed_args["max-error-reports"].count()) {
+            error_options.max_reports_per_type = parsed_args["max-error-reports"].as<uint64_t>();
+        }
+        error_options.summary_interval = std::chrono::seconds{parsed_args["error-summary-interval"].as<uint64_t>()};
+        if (parsed_args["quarantine"].count()) {
+            error_options.quarantine_path = parsed_args["quarantine"].as<std::string>();
+        }
+        try {
+            return rdf4cpp::rdftools::parser::ErrorReporter{std::move(error_options), recent_lines ? &*recent_lines : nullptr};
+        } catch (std::runtime_error const &e) {
+            std::cerr << e.what() << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }();
+
+    /*
+     * Deduplicate. The loop is instantiated for each deduplication set, so that inserting hashes is not dispatched dynamically.
+     * @return false if writing the output failed
+     */
+    auto deduplicate = [&](auto &&insert_hash) -> bool {
+        for (rdf4cpp::rdftools::parser::IStreamQuadIterator qit{tracked_in ? *tracked_in : *in,
+                                                                 rdf4cpp::rdftools::parser::ParsingFlags::none(),
+                                                                 {},
+                                                                 error_reporter.error_message_filter(),
+                                                                 {},
+                                                                 not live_input};
+             qit != rdf4cpp::rdftools::parser::IStreamQuadIterator{}; ++qit) {
+            if (qit->has_value()) {
+                error_reporter.count_parsed();
+                auto const &quad = qit->value();
+                auto const hash = hash_quad(quad);
+                if (insert_hash(hash)) {
+                    if (limit_reached()) {
+                        break;
+                    }
+                    if (dictionary_writer) {
+                        try {
+                            dictionary_writer->add(quad[1].view(), quad[2].view(), quad[3].view());
+                        } catch (std::runtime_error const &e) {
+                            spdlog::error(e.what());
+                            return false;
+                        }
+                    } else if (turtle_writer) {
+                        if (auto const &prefixes = qit.prefixes(); prefixes.size() != declared_prefixes) {
+                            for (auto const &[name, namespace_iri] : prefixes) {
+                                turtle_writer->declare_prefix(name, namespace_iri);
+                            }
+                            declared_prefixes = prefixes.size();
+                        }
+                        turtle_writer->write(quad[1].view(), quad[2].view(), quad[3].view());
+                    } else {
+                        (*out) << fmt::format("{} {} {} .\n",
+                                              static_cast<std::string>(quad[1]),
+                                              static_cast<std::string>(quad[2]),
+                                              static_cast<std::string>(quad[3]));
+                    }
+                }
+            } else {
+                error_reporter.report(qit->error());
             }
+        }
+        return true;
+    };
+
+    bool const deduplicated = [&]() {
+        if (windowed) {
+            auto deduplication = [&]() -> rdf4cpp::rdftools::dedup::WindowedHashSet {
+                try {
+                    if (parsed_args["window"].count()) {
+                        return rdf4cpp::rdftools::dedup::WindowedHashSet{parsed_args["window"].as<size_t>()};
+                    }
+                    return rdf4cpp::rdftools::dedup::WindowedHashSet::with_memory_budget(parsed_args["window-bytes"].as<size_t>());
+                } catch (std::invalid_argument const &e) {
+                    std::cerr << e.what() << std::endl;
+                    exit(EXIT_FAILURE);
+                }
+            }();
+            spdlog::info("Deduplicating within a window of the {} most recent distinct triples ({:.1f} MiB).",
+                         deduplication.window(), static_cast<double>(deduplication.memory_usage()) / (1024.0 * 1024.0));
+            return deduplicate([&deduplication](uint64_t const hash) { return deduplication.insert(hash); });
+        } else if (dedup_set == "compact") {
+            rdf4cpp::rdftools::dedup::CompactHashSet deduplication;
+            auto const ok = deduplicate([&deduplication](uint64_t const hash) { return deduplication.insert(hash); });
+            spdlog::info("Compact deduplication set holds {} distinct triples in {:.1f} MiB.",
+                         deduplication.size(), static_cast<double>(deduplication.memory_usage()) / (1024.0 * 1024.0));
+            return ok;
         } else {
-            std::stringstream sb;
-            sb << qit->error();
-            spdlog::warn(sb.str());
+            // hashmap for deduplication
+            rdf4cpp::rdf::storage::util::tsl::sparse_set<uint64_t, uint64_fast_hash> deduplication;
+            return deduplicate([&deduplication](uint64_t const hash) { return deduplication.insert(hash).second; });
+        }
+    }();
+    if (not deduplicated) {
+        return EXIT_FAILURE;
+    }
+    // std::istream turns exceptions of its streambuf (e.g. a failed io_uring read) into badbit, which looks like the end of input to the parser
+    if (in->bad() or (tracked_in and tracked_in->bad())) {
+        spdlog::error("Reading the input failed. The output is incomplete.");
+        return EXIT_FAILURE;
+    }
+    error_reporter.finish();
+    if (dictionary_writer) {
+        spdlog::info("Writing dictionary with {} terms and {} ID triples.",
+                     dictionary_writer->num_terms(), dictionary_writer->num_triples());
+        try {
+            dictionary_writer->finish();
+        } catch (std::runtime_error const &e) {
+            spdlog::error(e.what());
+            return EXIT_FAILURE;
         }
+    } else {
+        if (turtle_writer) {
+            turtle_writer->finish();
+        }
+        out->flush();
     }
-    out->flush();
     spdlog::info("Shutdown successful.");
     return EXIT_SUCCESS;
 }
-
@@ -0,0 +1,538 @@
+#include "SetOperations.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <dedup/hash_quad.hpp>
+#include <dictionary/MappedFile.hpp>
+#include <io/FileRange.hpp>
+#include <parser/IStreamQuadIterator.hpp>
+#include <parser/TurtleSplitter.hpp>
+
+#include "TripleSet.hpp"
+
+namespace rdf4cpp::rdftools::diff {
+
+    namespace {
+
+        namespace fs = std::filesystem;
+
+        bool has_extension(fs::path const &path, std::initializer_list<std::string_view> const extensions) {
+            auto ext = path.extension().string();
+            std::ranges::transform(ext, ext.begin(), [](unsigned char const c) { return std::tolower(c); });
+            return std::ranges::find(extensions, std::string_view{ext}) != extensions.end();
+        }
+
+        /**
+         * Extension of the partition files written by partition(). They hold (hash, triple) records instead of RDF, so that their
+         * triples are not parsed again: a parser would rename the generated blank node labels of the first parse.
+         * A record is the 64-bit hash, the 32-bit length of the triple and the N-Triples text of the triple without the trailing " .",
+         * all in native byte order.
+         */
+        constexpr std::string_view spill_extension = ".rdfdiff-spill";
+
+        void write_spilled(std::ostream &out, uint64_t const hash, std::string_view const triple) {
+            if (triple.size() > std::numeric_limits<uint32_t>::max()) {
+                throw std::runtime_error{"Triple too large for a partition file."};
+            }
+            auto const size = static_cast<uint32_t>(triple.size());
+            out.write(reinterpret_cast<char const *>(&hash), sizeof(hash));
+            out.write(reinterpret_cast<char const *>(&size), sizeof(size));
+            out.write(triple.data(), static_cast<std::streamsize>(triple.size()));
+        }
+
+        /**
+         * Calls f(hash, triple) for each record of a partition file.
+         * @throws std::runtime_error if the file cannot be read or is truncated
+         */
+        template<typename F>
+        uint64_t for_each_spilled_triple(fs::path const &path, F &&f) {
+            dictionary::MappedFile const file{path};
+            auto const *const data = reinterpret_cast<char const *>(file.bytes().data());
+
+            uint64_t n_triples = 0;
+            for (size_t pos = 0; pos < file.size(); ++n_triples) {
+                uint64_t hash;
+                uint32_t size;
+                if (file.size() - pos < sizeof(hash) + sizeof(size)) {
+                    throw std::runtime_error{fmt::format("Partition file {} is truncated.", path.string())};
+                }
+                std::memcpy(&hash, data + pos, sizeof(hash));
+                std::memcpy(&size, data + pos + sizeof(hash), sizeof(size));
+                pos += sizeof(hash) + sizeof(size);
+                if (file.size() - pos < size) {
+                    throw std::runtime_error{fmt::format("Partition file {} is truncated.", path.string())};
+                }
+                f(hash, std::string_view{data + pos, size});
+                pos += size;
+            }
+            return n_triples;
+        }
+
+        uint64_t size_of(Dataset const &dataset) {
+            return std::accumulate(dataset.begin(), dataset.end(), uint64_t{0},
+                                   [](uint64_t const sum, fs::path const &path) { return sum + fs::file_size(path); });
+        }
+
+        /**
+         * Part of a file that can be parsed independently.
+         */
+        struct Chunk {
+            io::FileRange range;
+            /**
+             * prefixes declared before range
+             */
+            parser::IStreamQuadIterator::prefix_storage_type prefixes;
+            /**
+             * keeps the anonymous blank nodes of different chunks of a file apart
+             */
+            std::string anonymous_blank_node_suffix;
+        };
+
+        Chunk whole_file(fs::path const &path) {
+            return Chunk{.range = io::FileRange{.path = path, .begin = 0, .end = fs::file_size(path)},
+                         .prefixes = {},
+                         .anonymous_blank_node_suffix = {}};
+        }
+
+        /**
+         * Splits a file into chunks that can be parsed independently.
+         * N-Triples files have one triple per line and are split at line breaks. Turtle files are split at statements.
+         */
+        std::vector<Chunk> chunks_of(fs::path const &path, size_t const threads) {
+            std::vector<Chunk> chunks;
+            if (has_extension(path, {spill_extension})) {
+                chunks.push_back(whole_file(path));
+            } else if (threads > 1 and has_extension(path, {".nt", ".ntriples"})) {
+                for (auto &range : io::split_at_line_breaks(path, threads)) {
+                    chunks.push_back(Chunk{.range = std::move(range), .prefixes = {}, .anonymous_blank_node_suffix = {}});
+                }
+            } else if (threads > 1 and has_extension(path, {".ttl", ".turtle"})) {
+                auto turtle_chunks = parser::split_at_statements(path, threads);
+                for (size_t i = 0; i < turtle_chunks.size(); ++i) {
+                    chunks.push_back(Chunk{.range = std::move(turtle_chunks[i].range),
+                                           .prefixes = std::move(turtle_chunks[i].prefixes),
+                                           // the first chunk keeps the labels of a sequential parse
+                                           .anonymous_blank_node_suffix = i == 0 ? std::string{} : fmt::format("_c{}", i)});
+                }
+            } else {
+                chunks.push_back(whole_file(path));
+            }
+            return chunks;
+        }
+
+        /**
+         * Parses chunk and calls f(hash, triple) for each triple. triple is the N-Triples text of the triple without the trailing " .".
+         * @param error_reporter reporter of the chunk's file. It is shared by all chunks of the file.
+         *      nullptr ignores errors, e.g. because an earlier pass over the chunk reported them already.
+         * @throws std::runtime_error if the file cannot be opened
+         */
+        template<typename F>
+        void for_each_triple(Chunk const &chunk, parser::ErrorReporter *const error_reporter, F &&f) {
+            if (has_extension(chunk.range.path, {spill_extension})) {
+                // chunks_of() does not split partition files
+                auto const n_triples = for_each_spilled_triple(chunk.range.path, f);
+                if (error_reporter != nullptr) {
+                    error_reporter->count_parsed(n_triples);
+                }
+                return;
+            }
+
+            io::FileRangeIStream in{chunk.range};
+            if (not in) {
+                throw std::runtime_error{fmt::format("Unable to open {}.", chunk.range.path.string())};
+            }
+
+            // line numbers of errors are relative to the start of the chunk
+            auto const origin = chunk.range.begin == 0 ? chunk.range.path.string()
+                                                       : fmt::format("{} (from byte {})", chunk.range.path.string(), chunk.range.begin);
+            std::string triple;
+            // parsed triples are counted in batches, because the reporter is shared between threads
+            uint64_t parsed = 0;
+            auto error_message_filter = error_reporter != nullptr ? error_reporter->error_message_filter()
+                                                                  : [](parser::ParsingError::Type) { return false; };
+            for (parser::IStreamQuadIterator qit{in, parser::ParsingFlags::none(), chunk.prefixes, std::move(error_message_filter),
+                                                 chunk.anonymous_blank_node_suffix};
+                 qit != parser::IStreamQuadIterator{}; ++qit) {
+                if (qit->has_value()) {
+                    if (++parsed == 1024 and error_reporter != nullptr) {
+                        error_reporter->count_parsed(parsed);
+                        parsed = 0;
+                    }
+                    auto const &quad = qit->value();
+                    triple.clear();
+                    fmt::format_to(std::back_inserter(triple), "{} {} {}", quad[1].view(), quad[2].view(), quad[3].view());
+                    f(dedup::hash_quad(quad), std::string_view{triple});
+                } else if (error_reporter != nullptr) {
+                    error_reporter->report(qit->error(), origin);
+                }
+            }
+            if (error_reporter != nullptr) {
+                error_reporter->count_parsed(parsed);
+            }
+        }
+
+        /**
+         * Streams the dataset sequentially, i.e. in input order.
+         * Each file is parsed in the same chunks as by collect(), so that anonymous blank nodes get the same labels in both.
+         * @param report_errors false if an earlier pass over the dataset reported its errors already
+         */
+        template<typename F>
+        void for_each_triple(Dataset const &dataset, Options const &options, F &&f, bool const report_errors = true) {
+            for (auto const &path : dataset) {
+                spdlog::info("Streaming {}.", path.string());
+                std::optional<parser::ErrorReporter> error_reporter;
+                if (report_errors) {
+                    error_reporter.emplace(options.error_options);
+                }
+                for (auto const &chunk : chunks_of(path, options.threads)) {
+                    for_each_triple(chunk, error_reporter ? &*error_reporter : nullptr, f);
+                }
+                if (error_reporter) {
+                    error_reporter->finish();
+                }
+            }
+        }
+
+        /**
+         * A chunk of a file of one of the datasets.
+         */
+        struct Task {
+            Chunk chunk;
+            size_t dataset;
+            parser::ErrorReporter *error_reporter;
+        };
+
+        /**
+         * Splits all files of the datasets into chunks.
+         * @param error_reporters receives one reporter per file. The tasks point to them.
+         */
+        std::vector<Task> tasks_of(std::vector<Dataset> const &datasets, Options const &options,
+                                   std::deque<parser::ErrorReporter> &error_reporters) {
+            std::vector<Task> tasks;
+            for (size_t i = 0; i < datasets.size(); ++i) {
+                for (auto const &path : datasets[i]) {
+                    auto &error_reporter = error_reporters.emplace_back(options.error_options);
+                    for (auto &chunk : chunks_of(path, options.threads)) {
+                        tasks.push_back(Task{.chunk = std::move(chunk), .dataset = i, .error_reporter = &error_reporter});
+                    }
+                }
+            }
+            return tasks;
+        }
+
+        /**
+         * Runs task(worker, i) for i in [0, n_tasks) on up to threads workers.
+         * If a task throws, no further tasks are started and the first exception is rethrown once all workers are done.
+         * @return number of workers used. worker is in [0, number of workers).
+         */
+        template<typename Task>
+        size_t run_parallel(size_t const n_tasks, size_t const threads, Task const &task) {
+            auto const n_workers = std::max(size_t{1}, std::min(threads, n_tasks));
+            std::atomic<size_t> next_task = 0;
+            std::mutex error_mutex;
+            std::exception_ptr error;
+            auto work = [&](size_t const worker) {
+                try {
+                    for (size_t i; (i = next_task.fetch_add(1, std::memory_order_relaxed)) < n_tasks;) {
+                        task(worker, i);
+                    }
+                } catch (...) {
+                    next_task = n_tasks;
+                    std::lock_guard const lock{error_mutex};
+                    if (not error) {
+                        error = std::current_exception();
+                    }
+                }
+            };
+            {
+                std::vector<std::jthread> workers;
+                for (size_t worker = 1; worker < n_workers; ++worker) {
+                    workers.emplace_back(work, worker);
+                }
+                work(0);
+            }
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return n_workers;
+        }
+
+        /**
+         * Loads all triples of the datasets for which keep(hash, triple) holds into a TripleSet. The files are parsed in parallel.
+         */
+        template<typename Keep>
+        TripleSet collect(std::vector<Dataset> const &datasets, Options const &options, Keep const &keep) {
+            for (auto const &dataset : datasets) {
+                for (auto const &path : dataset) {
+                    spdlog::info("Loading {}.", path.string());
+                }
+            }
+            std::deque<parser::ErrorReporter> error_reporters;
+            auto const tasks = tasks_of(datasets, options, error_reporters);
+
+            std::vector<TripleSet> sets(std::max(size_t{1}, std::min(options.threads, tasks.size())), TripleSet{options.exact});
+            auto const n_workers = run_parallel(tasks.size(), options.threads, [&](size_t const worker, size_t const i) {
+                auto &set = sets[worker];
+                for_each_triple(tasks[i].chunk, tasks[i].error_reporter, [&](uint64_t const hash, std::string_view const triple) {
+                    if (keep(hash, triple)) {
+                        set.insert(hash, triple);
+                    }
+                });
+            });
+
+            for (auto &error_reporter : error_reporters) {
+                error_reporter.finish();
+            }
+
+            for (size_t worker = 1; worker < n_workers; ++worker) {
+                sets[0].merge(std::move(sets[worker]));
+            }
+            return std::move(sets[0]);
+        }
+
+        TripleSet collect(std::vector<Dataset> const &datasets, Options const &options) {
+            return collect(datasets, options, [](uint64_t, std::string_view) { return true; });
+        }
+
+        class Output {
+            std::ostream &out;
+            uint64_t count = 0;
+
+        public:
+            explicit Output(std::ostream &out) noexcept : out{out} {}
+
+            void write(std::string_view const triple) {
+                this->out.write(triple.data(), static_cast<std::streamsize>(triple.size()));
+                this->out.write(" .\n", 3);
+                ++this->count;
+            }
+
+            /**
+             * @param lines n_triples complete N-Triples lines
+             */
+            void write_lines(std::string_view const lines, uint64_t const n_triples) {
+                this->out.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+                this->count += n_triples;
+            }
+
+            [[nodiscard]] uint64_t num_written() const noexcept {
+                return this->count;
+            }
+        };
+
+        uint64_t run_union(std::vector<Dataset> const &datasets, std::ostream &out, Options const &options) {
+            // all files are parsed in parallel. The written triples are sharded by the high bits of their hash
+            // (the sets use the low bits), so that the workers rarely wait for each other.
+            static constexpr size_t shard_bits = 6;
+            static constexpr size_t output_batch_size = 1UL << 16;
+
+            for (auto const &dataset : datasets) {
+                for (auto const &path : dataset) {
+                    spdlog::info("Loading {}.", path.string());
+                }
+            }
+            std::deque<parser::ErrorReporter> error_reporters;
+            auto const tasks = tasks_of(datasets, options, error_reporters);
+
+            std::vector<TripleSet> written(size_t{1} << shard_bits, TripleSet{options.exact});
+            std::vector<std::mutex> written_mutexes(written.size());
+            Output output{out};
+            std::mutex output_mutex;
+            run_parallel(tasks.size(), options.threads, [&](size_t, size_t const i) {
+                std::string batch;
+                uint64_t batch_triples = 0;
+                auto const write_batch = [&] {
+                    std::lock_guard const lock{output_mutex};
+                    output.write_lines(batch, batch_triples);
+                    batch.clear();
+                    batch_triples = 0;
+                };
+                for_each_triple(tasks[i].chunk, tasks[i].error_reporter, [&](uint64_t const hash, std::string_view const triple) {
+                    auto const shard = hash >> (64 - shard_bits);
+                    {
+                        std::lock_guard const lock{written_mutexes[shard]};
+                        if (not written[shard].insert(hash, triple)) {
+                            return;
+                        }
+                    }
+                    batch.append(triple);
+                    batch.append(" .\n");
+                    if (++batch_triples == output_batch_size) {
+                        write_batch();
+                    }
+                });
+                write_batch();
+            });
+
+            for (auto &error_reporter : error_reporters) {
+                error_reporter.finish();
+            }
+            return output.num_written();
+        }
+
+        uint64_t run_intersection(std::vector<Dataset> const &datasets, std::ostream &out, Options const &options) {
+            // start with the smallest dataset, filter it through all but the largest one and stream the largest one against the result
+            std::vector<uint64_t> sizes;
+            std::ranges::transform(datasets, std::back_inserter(sizes), size_of);
+            std::vector<size_t> order(datasets.size());
+            std::iota(order.begin(), order.end(), size_t{0});
+            std::ranges::stable_sort(order, {}, [&](size_t const i) { return sizes[i]; });
+
+            auto candidates = collect({datasets[order.front()]}, options);
+            for (size_t k = 1; k + 1 < order.size() and candidates.size() > 0; ++k) {
+                candidates = collect({datasets[order[k]]}, options, [&candidates](uint64_t const hash, std::string_view const triple) {
+                    return candidates.contains(hash, triple);
+                });
+            }
+
+            Output output{out};
+            if (candidates.size() > 0) {
+                for_each_triple(datasets[order.back()], options, [&](uint64_t const hash, std::string_view const triple) {
+                    // erasing makes sure that each triple is written only once
+                    if (candidates.erase(hash, triple)) {
+                        output.write(triple);
+                    }
+                });
+            }
+            return output.num_written();
+        }
+
+        uint64_t run_difference(std::vector<Dataset> const &datasets, std::ostream &out, Options const &options) {
+            std::vector<Dataset> const subtrahends(std::next(datasets.begin()), datasets.end());
+            auto const subtrahends_size = std::accumulate(subtrahends.begin(), subtrahends.end(), uint64_t{0},
+                                                          [](uint64_t const sum, Dataset const &dataset) { return sum + size_of(dataset); });
+
+            Output output{out};
+            if (size_of(datasets.front()) <= subtrahends_size) {
+                // hold the minuend in memory, remove everything that occurs in the subtrahends and write the rest in input order
+                auto remaining = collect({datasets.front()}, options);
+                auto const removed = collect(subtrahends, options, [&remaining](uint64_t const hash, std::string_view const triple) {
+                    return remaining.contains(hash, triple);
+                });
+                remaining.erase_all(removed);
+                if (remaining.size() > 0) {
+                    // the errors of the minuend were reported while loading it
+                    for_each_triple(
+                            datasets.front(), options, [&](uint64_t const hash, std::string_view const triple) {
+                                if (remaining.erase(hash, triple)) {
+                                    output.write(triple);
+                                }
+                            },
+                            false);
+                }
+            } else {
+                // hold the subtrahends in memory and stream the minuend against them.
+                // Written triples are added to the set, so that duplicates in the minuend are written only once.
+                auto excluded = collect(subtrahends, options);
+                for_each_triple(datasets.front(), options, [&](uint64_t const hash, std::string_view const triple) {
+                    if (excluded.insert(hash, triple)) {
+                        output.write(triple);
+                    }
+                });
+            }
+            return output.num_written();
+        }
+
+    }  // namespace
+
+    uint64_t run(std::vector<Dataset> const &datasets, std::ostream &out, Options const &options) {
+        switch (options.operation) {
+            case Operation::Union:
+                return run_union(datasets, out, options);
+            case Operation::Intersection:
+                return run_intersection(datasets, out, options);
+            case Operation::Difference:
+                return run_difference(datasets, out, options);
+        }
+        return 0;
+    }
+
+    std::vector<std::vector<Dataset>> partition(std::vector<Dataset> const &datasets, fs::path const &dir,
+                                                size_t const n_partitions, Options const &options) {
+        std::deque<parser::ErrorReporter> error_reporters;
+        auto const tasks = tasks_of(datasets, options, error_reporters);
+
+        // every task writes its own partition files, so no synchronization is needed
+        std::vector<std::vector<fs::path>> task_files(tasks.size());
+        for (size_t t = 0; t < tasks.size(); ++t) {
+            for (size_t p = 0; p < n_partitions; ++p) {
+                task_files[t].push_back(dir / fmt::format("rdfdiff-{}-{}-{}{}", ::getpid(), t, p, spill_extension));
+            }
+        }
+
+        auto const remove_partition_files = [&task_files] {
+            for (auto const &files : task_files) {
+                for (auto const &path : files) {
+                    std::error_code ec;
+                    fs::remove(path, ec);
+                }
+            }
+        };
+
+        std::atomic<bool> failed = false;
+        try {
+            run_parallel(tasks.size(), options.threads, [&](size_t, size_t const t) {
+                auto const &range = tasks[t].chunk.range;
+                spdlog::info("Partitioning {} [{}, {}).", range.path.string(), range.begin, range.end);
+                std::vector<std::ofstream> files;
+                for (auto const &path : task_files[t]) {
+                    files.emplace_back(path, std::ios::binary);
+                    if (not files.back().is_open()) {
+                        spdlog::error("Unable to open partition file {}.", path.string());
+                        failed = true;
+                        return;
+                    }
+                }
+                for_each_triple(tasks[t].chunk, tasks[t].error_reporter, [&](uint64_t const hash, std::string_view const triple) {
+                    write_spilled(files[hash % n_partitions], hash, triple);
+                });
+                for (auto &file : files) {
+                    file.flush();
+                    if (not file) {
+                        failed = true;
+                    }
+                }
+            });
+        } catch (...) {
+            remove_partition_files();
+            throw;
+        }
+        for (auto &error_reporter : error_reporters) {
+            error_reporter.finish();
+        }
+        if (failed) {
+            remove_partition_files();
+            throw std::runtime_error{fmt::format("Writing partition files to {} failed.", dir.string())};
+        }
+
+        std::vector<std::vector<Dataset>> partitions(n_partitions, std::vector<Dataset>(datasets.size()));
+        for (size_t t = 0; t < tasks.size(); ++t) {
+            for (size_t p = 0; p < n_partitions; ++p) {
+                partitions[p][tasks[t].dataset].push_back(std::move(task_files[t][p]));
+            }
+        }
+        return partitions;
+    }
+
+}  // namespace rdf4cpp::rdftools::diff
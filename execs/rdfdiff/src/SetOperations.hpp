@@ -0,0 +1,71 @@
+#ifndef RDFTOOLS_SETOPERATIONS_HPP
+#define RDFTOOLS_SETOPERATIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <vector>
+
+#include <parser/ErrorReporter.hpp>
+
+namespace rdf4cpp::rdftools::diff {
+
+enum struct Operation {
+    Union,
+    Intersection,
+    /**
+     * Triples of the first dataset that are in none of the other datasets.
+     */
+    Difference,
+};
+
+/**
+ * A dataset. It may consist of several files, e.g. the partitions of a spilled input.
+ */
+using Dataset = std::vector<std::filesystem::path>;
+
+struct Options {
+    Operation operation = Operation::Union;
+    /**
+     * Compare triples by their text instead of only by their hash. See TripleSet.
+     */
+    bool exact = false;
+    size_t threads = 1;
+    parser::ErrorReporter::Options error_options{};
+};
+
+/**
+ * Computes the operation over the datasets and writes the resulting triples as N-Triples to out.
+ *
+ * Each result triple is written only once. Datasets that are loaded into a TripleSet are loaded in parallel (N-Triples files are
+ * split at line breaks and Turtle files at statements, so even a single file is loaded by all threads). Union parses all datasets
+ * in parallel, so with several threads its result is not in input order. Memory usage depends on the operation:
+ *  - Union: all distinct triples of all datasets, because they are needed to write each triple once.
+ *  - Intersection: the distinct triples of the smallest dataset. The largest dataset is streamed.
+ *  - Difference with a minuend that is not larger than the subtrahends: the distinct triples of the minuend.
+ *  - Difference with a larger minuend: the distinct triples of the subtrahends plus the distinct result triples.
+ * If that does not fit into memory, use partition() and run the operation per partition.
+ *
+ * @param datasets at least two datasets. For Operation::Difference the first one is the minuend.
+ * @return number of result triples
+ * @throws std::runtime_error if an input file cannot be read. The result written so far is incomplete.
+ */
+uint64_t run(std::vector<Dataset> const &datasets, std::ostream &out, Options const &options);
+
+/**
+ * Grace hash partitioning. Splits the datasets by triple hash into n_partitions files each,
+ * so that the operation can be computed partition by partition with run() in a fraction of the memory.
+ * The partition files hold the hash and the text of each triple instead of RDF. run() reads them without parsing, so generated
+ * blank node labels are kept as they are and the result is the same as without partitioning.
+ *
+ * @param dir directory for the partition files. The caller is responsible for deleting them.
+ * @return partitions[p][i] is partition p of dataset i
+ * @throws std::runtime_error if an input file cannot be read or a partition file cannot be written. No partition files are left behind.
+ */
+std::vector<std::vector<Dataset>> partition(std::vector<Dataset> const &datasets, std::filesystem::path const &dir,
+                                            size_t n_partitions, Options const &options);
+
+}  // namespace rdf4cpp::rdftools::diff
+
+#endif  // RDFTOOLS_SETOPERATIONS_HPP
@@ -0,0 +1,121 @@
+#include "TripleSet.hpp"
+
+#include <utility>
+
+namespace rdf4cpp::rdftools::diff {
+
+    bool TripleSet::insert(uint64_t const hash, std::string_view const triple) {
+        if (not this->exact) {
+            return this->hashes.insert(hash).second;
+        }
+
+        auto const it = this->texts.find(hash);
+        if (it == this->texts.end()) {
+            this->texts.emplace(hash, std::string{triple});
+            return true;
+        }
+        if (it->second == triple) {
+            return false;
+        }
+        auto const [first, last] = this->collisions.equal_range(hash);
+        for (auto cit = first; cit != last; ++cit) {
+            if (cit->second == triple) {
+                return false;
+            }
+        }
+        this->collisions.emplace(hash, std::string{triple});
+        return true;
+    }
+
+    bool TripleSet::contains(uint64_t const hash, std::string_view const triple) const {
+        if (not this->exact) {
+            return this->hashes.contains(hash);
+        }
+
+        auto const it = this->texts.find(hash);
+        if (it == this->texts.end()) {
+            return false;
+        }
+        if (it->second == triple) {
+            return true;
+        }
+        auto const [first, last] = this->collisions.equal_range(hash);
+        for (auto cit = first; cit != last; ++cit) {
+            if (cit->second == triple) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TripleSet::erase(uint64_t const hash, std::string_view const triple) {
+        if (not this->exact) {
+            return this->hashes.erase(hash) > 0;
+        }
+
+        auto const it = this->texts.find(hash);
+        if (it == this->texts.end()) {
+            return false;
+        }
+        auto const [first, last] = this->collisions.equal_range(hash);
+        if (it->second == triple) {
+            this->texts.erase(it);
+            if (first != last) {
+                // keep the invariant that every hash in collisions is also in texts
+                this->texts.emplace(hash, std::move(first->second));
+                this->collisions.erase(first);
+            }
+            return true;
+        }
+        for (auto cit = first; cit != last; ++cit) {
+            if (cit->second == triple) {
+                this->collisions.erase(cit);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TripleSet::merge(TripleSet &&other) {
+        if (not this->exact) {
+            if (this->hashes.size() < other.hashes.size()) {
+                std::swap(this->hashes, other.hashes);
+            }
+            for (auto const hash : other.hashes) {
+                this->hashes.insert(hash);
+            }
+            other.hashes.clear();
+            return;
+        }
+
+        if (this->size() < other.size()) {
+            std::swap(this->texts, other.texts);
+            std::swap(this->collisions, other.collisions);
+        }
+        for (auto const &[hash, triple] : other.texts) {
+            this->insert(hash, triple);
+        }
+        for (auto const &[hash, triple] : other.collisions) {
+            this->insert(hash, triple);
+        }
+        other.texts.clear();
+        other.collisions.clear();
+    }
+
+    void TripleSet::erase_all(TripleSet const &other) {
+        if (not this->exact) {
+            for (auto const hash : other.hashes) {
+                this->hashes.erase(hash);
+            }
+            return;
+        }
+
+        for (auto const &[hash, triple] : other.texts) {
+            this->erase(hash, triple);
+        }
+        for (auto const &[hash, triple] : other.collisions) {
+            this->erase(hash, triple);
+        }
+    }
+
+}  // namespace rdf4cpp::rdftools::diff
@@ -0,0 +1,74 @@
+#ifndef RDFTOOLS_TRIPLESET_HPP
+#define RDFTOOLS_TRIPLESET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <rdf4cpp/rdf/storage/util/tsl/sparse_map.h>
+#include <rdf4cpp/rdf/storage/util/tsl/sparse_set.h>
+
+#include <dedup/hash_quad.hpp>
+
+namespace rdf4cpp::rdftools::diff {
+
+/**
+ * Set of triples identified by their 64-bit hash.
+ *
+ * By default only the hashes are stored, i.e. two distinct triples with the same hash are considered equal.
+ * In exact mode the N-Triples text of each triple is stored as well and compared on every lookup, so hash collisions
+ * cannot produce wrong results at the cost of considerably more memory.
+ */
+class TripleSet {
+    using hash_set_type = rdf4cpp::rdf::storage::util::tsl::sparse_set<uint64_t, dedup::uint64_fast_hash>;
+    using text_map_type = rdf4cpp::rdf::storage::util::tsl::sparse_map<uint64_t, std::string, dedup::uint64_fast_hash>;
+
+    bool exact;
+    // hash mode
+    hash_set_type hashes;
+    // exact mode: the first triple with a given hash
+    text_map_type texts;
+    // exact mode: further triples whose hash is already used in texts. Real collisions are rare, so this stays small.
+    std::unordered_multimap<uint64_t, std::string> collisions;
+
+public:
+    explicit TripleSet(bool exact = false) noexcept : exact{exact} {}
+
+    /**
+     * @param hash hash of the triple
+     * @param triple N-Triples text of the triple. Only used in exact mode.
+     * @return true if the triple was not contained before
+     */
+    bool insert(uint64_t hash, std::string_view triple);
+
+    [[nodiscard]] bool contains(uint64_t hash, std::string_view triple) const;
+
+    /**
+     * @return true if the triple was contained
+     */
+    bool erase(uint64_t hash, std::string_view triple);
+
+    /**
+     * Inserts all triples of other.
+     */
+    void merge(TripleSet &&other);
+
+    /**
+     * Erases all triples of other.
+     */
+    void erase_all(TripleSet const &other);
+
+    [[nodiscard]] size_t size() const noexcept {
+        return this->exact ? this->texts.size() + this->collisions.size() : this->hashes.size();
+    }
+
+    [[nodiscard]] bool is_exact() const noexcept {
+        return this->exact;
+    }
+};
+
+}  // namespace rdf4cpp::rdftools::diff
+
+#endif  // RDFTOOLS_TRIPLESET_HPP
@@ -0,0 +1,201 @@
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <thread>
+
+#include <cxxopts.hpp>
+#include <fmt/format.h>
+
+#include <rdf4cpp/rdf/version.hpp>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "SetOperations.hpp"
+#include "rdftools_version.hpp"
+
+/**
+ * Destructor for std::ostream holding either an owned std::ofstream or std::cout. std::cout is not deleted.
+ */
+auto ostream_destructor = [](std::ostream *os_ptr) {
+    if (os_ptr and os_ptr != &std::cout) {
+        delete os_ptr;
+    }
+};
+
+int main(int argc, char *argv[]) {
+    static constexpr auto tool_name = "rdfdiff";
+    namespace fs = std::filesystem;
+    using namespace rdf4cpp::rdftools::diff;
+    /*
+     * Parse Commandline Arguments
+     */
+    cxxopts::Options options(tool_name,
+                             fmt::format(
+                                     "{}\nComputes the union, intersection or difference of RDF files (TURTLE, NTRIPLE). Result is serialized in NTRIPLE on console out. Logs are written to console error.\n"
+                                     "Based on {} v{}",
+                                     ::rdf4cpp::rdftools::version,
+                                     ::dice::rdf4cpp::name, ::dice::rdf4cpp::version));
+    {
+        options.add_options()
+                ("O,operation", "union, intersection or difference. difference yields the triples of the first file that are in none of the other files.",
+                 cxxopts::value<std::string>())
+                ("inputs", "TURTLE or NTRIPLE RDF files, at least two.",
+                 cxxopts::value<std::vector<std::string>>())
+                ("o,output", "(optional) file to write result to. The file will be overwritten.",
+                 cxxopts::value<std::string>())
+                ("t,threads", "(optional) number of threads for loading files. NTRIPLE (.nt) and TURTLE (.ttl) files are split, so that even a single file is loaded in parallel.",
+                 cxxopts::value<size_t>()->default_value(std::to_string(std::max(1U, std::thread::hardware_concurrency()))))
+                ("exact", "(optional) compare triples by their text instead of only by their 64-bit hash. "
+                          "Rules out errors from hash collisions but needs considerably more memory.")
+                ("spill-dir", "(optional) partition the inputs by triple hash into temporary files in this directory and process one partition at a time. "
+                              "Use it if the operation does not fit into memory: union holds all distinct triples, intersection the smallest input "
+                              "and difference the smaller side plus, for a larger first input, the result.",
+                 cxxopts::value<std::string>())
+                ("spill-partitions", "(optional) number of partitions for --spill-dir.",
+                 cxxopts::value<size_t>()->default_value("16"))
+                ("max-error-reports", "(optional) Log only the first n parsing errors of each type per file individually. "
+                                      "Further errors are counted and summarized.",
+                 cxxopts::value<uint64_t>())
+                ("v,version", "Version info.")
+                ("h,help", "Print this help page.");
+    }
+    options.parse_positional({"inputs"});
+    options.positional_help("<file> <file>...");
+    auto parsed_args = options.parse(argc, argv);
+    if (parsed_args.count("help")) {
+        std::cerr << options.help() << std::endl;
+        exit(EXIT_SUCCESS);
+    } else if (parsed_args.count("version")) {
+        std::cerr << ::rdf4cpp::rdftools::version << std::endl;
+        exit(EXIT_SUCCESS);
+    }
+
+    Options diff_options;
+    if (not parsed_args["operation"].count()) {
+        std::cerr << "Specify an operation via '--operation'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (auto const operation = parsed_args["operation"].as<std::string>(); operation == "union") {
+        diff_options.operation = Operation::Union;
+    } else if (operation == "intersection") {
+        diff_options.operation = Operation::Intersection;
+    } else if (operation == "difference") {
+        diff_options.operation = Operation::Difference;
+    } else {
+        std::cerr << "Unknown operation " << operation << ". Use either union, intersection or difference." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    diff_options.exact = parsed_args.count("exact") > 0;
+    diff_options.threads = std::max(size_t{1}, parsed_args["threads"].as<size_t>());
+    if (parsed_args["max-error-reports"].count()) {
+        diff_options.error_options.max_reports_per_type = parsed_args["max-error-reports"].as<uint64_t>();
+    }
+
+    std::vector<Dataset> datasets;
+    if (parsed_args["inputs"].count()) {
+        for (auto const &input : parsed_args["inputs"].as<std::vector<std::string>>()) {
+            auto const file_path = fs::path(input);
+            // make sure that the file can be opened
+            if (not fs::is_regular_file(file_path)) {
+                std::cerr << file_path << " does not exist or is not a regular file." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            datasets.push_back(Dataset{file_path});
+        }
+    }
+    if (datasets.size() < 2) {
+        std::cerr << "Specify at least two input files." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    auto const spill_dir = parsed_args["spill-dir"].count() ? std::optional<fs::path>{parsed_args["spill-dir"].as<std::string>()}
+                                                            : std::nullopt;
+    auto const spill_partitions = parsed_args["spill-partitions"].as<size_t>();
+    if (spill_dir) {
+        if (not fs::is_directory(*spill_dir)) {
+            std::cerr << *spill_dir << " is not a directory." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        if (spill_partitions == 0) {
+            std::cerr << "--spill-partitions must be at least 1." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    /*
+     * Initialize logger
+     */
+    spdlog::set_default_logger(spdlog::stderr_color_mt(std::string{tool_name} + "_logger"));
+    spdlog::set_level(spdlog::level::info);
+    spdlog::set_pattern("%Y-%m-%dT%T.%e%z | %n | %t | %l | %v");
+    spdlog::info("{} v{} based on {} v{}",
+                 tool_name, ::rdf4cpp::rdftools::version,
+                 ::dice::rdf4cpp::name, ::dice::rdf4cpp::version);
+
+    /*
+     * Select output to file or pipe
+     */
+    auto out = [&]() -> std::unique_ptr<std::ostream, decltype(ostream_destructor)> {
+        if (parsed_args["output"].count()) {
+            auto const file_path = fs::path(parsed_args["output"].as<std::string>());
+            auto ofs = std::unique_ptr<std::ofstream, decltype(ostream_destructor)>{
+                    new std::ofstream{file_path, std::ios::binary}, ostream_destructor};
+            if (not ofs->is_open()) {
+                std::cerr << "Unable to open output file " << file_path << "." << std::endl;
+                exit(EXIT_FAILURE);
+            }
+            return ofs;
+        } else {
+            return std::unique_ptr<std::ostream, decltype(ostream_destructor)>{&std::cout, ostream_destructor};
+        }
+    }();
+
+    uint64_t result_triples = 0;
+    if (not spill_dir) {
+        try {
+            result_triples = run(datasets, *out, diff_options);
+        } catch (std::runtime_error const &e) {
+            spdlog::error(e.what());
+            return EXIT_FAILURE;
+        }
+    } else {
+        std::vector<std::vector<Dataset>> partitions;
+        try {
+            partitions = partition(datasets, *spill_dir, spill_partitions, diff_options);
+        } catch (std::runtime_error const &e) {
+            spdlog::error(e.what());
+            return EXIT_FAILURE;
+        }
+        auto const remove_partition = [&partitions](size_t const p) {
+            for (auto const &dataset : partitions[p]) {
+                for (auto const &path : dataset) {
+                    std::error_code ec;
+                    fs::remove(path, ec);
+                }
+            }
+        };
+        for (size_t p = 0; p < partitions.size(); ++p) {
+            spdlog::info("Processing partition {} of {}.", p + 1, partitions.size());
+            try {
+                result_triples += run(partitions[p], *out, diff_options);
+            } catch (std::runtime_error const &e) {
+                spdlog::error(e.what());
+                for (; p < partitions.size(); ++p) {
+                    remove_partition(p);
+                }
+                return EXIT_FAILURE;
+            }
+            remove_partition(p);
+        }
+    }
+    out->flush();
+    if (not *out) {
+        spdlog::error("Writing the result failed.");
+        return EXIT_FAILURE;
+    }
+    spdlog::info("Wrote {} triples.", result_triples);
+    spdlog::info("Shutdown successful.");
+    return EXIT_SUCCESS;
+}
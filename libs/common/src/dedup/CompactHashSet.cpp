@@ -0,0 +1,255 @@
+#include <dedup/CompactHashSet.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+namespace rdf4cpp::rdftools::dedup {
+
+    namespace {
+
+        /**
+         * Reads width bits starting at bit_pos.
+         */
+        auto read_bits(uint64_t const *words, uint64_t const bit_pos, unsigned const width) noexcept -> uint64_t {
+            auto const idx = bit_pos / 64;
+            auto const shift = bit_pos % 64;
+
+            uint64_t value = words[idx] >> shift;
+            if (shift + width > 64) {
+                value |= words[idx + 1] << (64 - shift);
+            }
+            return width == 64 ? value : value & ((uint64_t{1} << width) - 1);
+        }
+
+        /**
+         * Writes the lower width bits of value starting at bit_pos. The target bits must be zero.
+         */
+        void write_bits(uint64_t *words, uint64_t const bit_pos, uint64_t const value, unsigned const width) noexcept {
+            auto const idx = bit_pos / 64;
+            auto const shift = bit_pos % 64;
+
+            words[idx] |= value << shift;
+            if (shift + width > 64) {
+                words[idx + 1] |= value >> (64 - shift);
+            }
+        }
+
+        /**
+         * Finds the last element whose key is <= hash in a range that is sorted by key.
+         * The keys are uniformly distributed hashes, so interpolating between the first and the last key usually hits the element
+         * or one of its neighbours and touches fewer cache lines than a binary search.
+         * @return index of the element or the size of the range if all keys are greater than hash
+         */
+        template<typename T, typename Key>
+        auto interpolation_search(std::vector<T> const &sorted, uint64_t const hash, Key &&key) noexcept -> size_t {
+            if (sorted.empty() or hash < key(sorted.front())) {
+                return sorted.size();
+            }
+
+            auto const n = sorted.size();
+            auto const lo = key(sorted.front());
+            auto const hi = key(sorted.back());
+            auto i = hash >= hi ? n - 1
+                                : static_cast<size_t>(static_cast<double>(hash - lo) / static_cast<double>(hi - lo) * static_cast<double>(n - 1));
+            while (i + 1 < n and key(sorted[i + 1]) <= hash) {
+                ++i;
+            }
+            while (key(sorted[i]) > hash) {
+                --i;
+            }
+            return i;
+        }
+
+    }  // namespace
+
+    bool CompactHashSet::Bucket::front_contains(uint64_t const hash) const noexcept {
+        auto const i = interpolation_search(this->front, hash, std::identity{});
+        return i != this->front.size() and this->front[i] == hash;
+    }
+
+    bool CompactHashSet::Bucket::compressed_contains(uint64_t const hash) const noexcept {
+        auto const i = interpolation_search(this->blocks, hash, [](BlockHeader const &block) { return block.first; });
+        if (i == this->blocks.size()) {
+            return false;
+        }
+
+        auto const &block = this->blocks[i];
+        uint64_t value = block.first;
+        uint64_t bit_pos = block.bit_offset;
+        for (size_t j = 0; value < hash and j + 1 < block.size; ++j) {
+            value += read_bits(this->packed_deltas.data(), bit_pos, block.delta_width);
+            bit_pos += block.delta_width;
+        }
+        return value == hash;
+    }
+
+    void CompactHashSet::Bucket::decode_into(std::vector<uint64_t> &out) const {
+        for (auto const &block : this->blocks) {
+            uint64_t value = block.first;
+            uint64_t bit_pos = block.bit_offset;
+            out.push_back(value);
+            for (size_t i = 1; i < block.size; ++i) {
+                value += read_bits(this->packed_deltas.data(), bit_pos, block.delta_width);
+                bit_pos += block.delta_width;
+                out.push_back(value);
+            }
+        }
+    }
+
+    void CompactHashSet::Bucket::encode(std::vector<uint64_t> const &sorted) {
+        std::vector<BlockHeader> new_blocks;
+        new_blocks.reserve((sorted.size() + block_size - 1) / block_size);
+
+        // first pass: block layout
+        uint64_t total_bits = 0;
+        for (size_t begin = 0; begin < sorted.size(); begin += block_size) {
+            auto const end = std::min(begin + block_size, sorted.size());
+            uint64_t max_delta = 0;
+            for (auto i = begin + 1; i < end; ++i) {
+                max_delta = std::max(max_delta, sorted[i] - sorted[i - 1]);
+            }
+
+            if (total_bits > std::numeric_limits<uint32_t>::max()) [[unlikely]] {
+                throw std::length_error{"CompactHashSet bucket overflow: too many hashes."};
+            }
+            auto const width = static_cast<uint8_t>(std::bit_width(max_delta));
+            new_blocks.push_back(BlockHeader{.first = sorted[begin],
+                                             .bit_offset = static_cast<uint32_t>(total_bits),
+                                             .delta_width = width,
+                                             .size = static_cast<uint8_t>(end - begin)});
+            total_bits += static_cast<uint64_t>(width) * (end - begin - 1);
+        }
+
+        // second pass: deltas
+        std::vector<uint64_t> new_packed_deltas((total_bits + 63) / 64, 0);
+        for (auto const &block : new_blocks) {
+            auto const begin = static_cast<size_t>(&block - new_blocks.data()) * block_size;
+            uint64_t bit_pos = block.bit_offset;
+            for (auto i = begin + 1; i < begin + block.size; ++i) {
+                write_bits(new_packed_deltas.data(), bit_pos, sorted[i] - sorted[i - 1], block.delta_width);
+                bit_pos += block.delta_width;
+            }
+        }
+
+        this->blocks = std::move(new_blocks);
+        this->packed_deltas = std::move(new_packed_deltas);
+        this->compressed_size = sorted.size();
+    }
+
+    void CompactHashSet::Bucket::merge_front() {
+        std::vector<uint64_t> compressed;
+        compressed.reserve(this->compressed_size);
+        this->decode_into(compressed);
+
+        std::vector<uint64_t> merged;
+        merged.reserve(compressed.size() + this->front.size());
+        std::merge(compressed.begin(), compressed.end(), this->front.begin(), this->front.end(), std::back_inserter(merged));
+
+        this->encode(merged);
+        // the buffer keeps its capacity, but is not reserved ahead. Otherwise, every bucket would cost at least min_front_capacity hashes.
+        this->front.clear();
+    }
+
+    size_t CompactHashSet::Bucket::front_capacity() const noexcept {
+        return std::max(min_front_capacity, this->compressed_size / front_capacity_divisor);
+    }
+
+    void CompactHashSet::Bucket::split_into(uint64_t const bit, Bucket &lower, Bucket &upper) const {
+        std::vector<uint64_t> all;
+        all.reserve(this->compressed_size + this->front.size());
+        this->decode_into(all);
+        auto const compressed_end = static_cast<std::ptrdiff_t>(all.size());
+        all.insert(all.end(), this->front.begin(), this->front.end());
+        std::inplace_merge(all.begin(), all.begin() + compressed_end, all.end());
+
+        // all hashes of the bucket share the bits above bit, so the ones with bit set form a suffix
+        auto const split = std::ranges::find_if(all, [bit](uint64_t const hash) { return (hash & bit) != 0; });
+        lower.encode(std::vector<uint64_t>(all.begin(), split));
+        upper.encode(std::vector<uint64_t>(split, all.end()));
+    }
+
+    CompactHashSet::CompactHashSet()
+        : radix_bits{initial_radix_bits},
+          buckets(size_t{1} << this->radix_bits) {
+    }
+
+    void CompactHashSet::grow() {
+        if (this->split_count == 0) {
+            this->split_buckets.resize(this->buckets.size() * 2);
+        }
+
+        auto const bit = uint64_t{1} << (63 - this->radix_bits);
+        auto const i = this->split_count;
+        this->buckets[i].split_into(bit, this->split_buckets[2 * i], this->split_buckets[2 * i + 1]);
+        // release the old bucket right away to limit the peak memory usage
+        this->buckets[i] = Bucket{};
+
+        if (++this->split_count == this->buckets.size()) {
+            this->buckets = std::move(this->split_buckets);
+            this->split_buckets = std::vector<Bucket>{};
+            this->split_count = 0;
+            ++this->radix_bits;
+        }
+    }
+
+    CompactHashSet::Bucket &CompactHashSet::bucket_of(uint64_t const hash) noexcept {
+        auto const i = hash >> (64 - this->radix_bits);
+        if (i < this->split_count) {
+            return this->split_buckets[hash >> (63 - this->radix_bits)];
+        }
+        return this->buckets[i];
+    }
+
+    CompactHashSet::Bucket const &CompactHashSet::bucket_of(uint64_t const hash) const noexcept {
+        auto const i = hash >> (64 - this->radix_bits);
+        if (i < this->split_count) {
+            return this->split_buckets[hash >> (63 - this->radix_bits)];
+        }
+        return this->buckets[i];
+    }
+
+    bool CompactHashSet::insert(uint64_t const hash) {
+        auto &bucket = this->bucket_of(hash);
+
+        // the last hash in the front buffer that is <= hash
+        auto const front_pos = interpolation_search(bucket.front, hash, std::identity{});
+        auto const front_found = front_pos != bucket.front.size();
+        if ((front_found and bucket.front[front_pos] == hash) or bucket.compressed_contains(hash)) {
+            return false;
+        }
+
+        auto const insert_pos = front_found ? front_pos + 1 : 0;
+        bucket.front.insert(bucket.front.begin() + static_cast<std::ptrdiff_t>(insert_pos), hash);
+        ++this->size_;
+
+        if (bucket.front.size() >= bucket.front_capacity()) {
+            bucket.merge_front();
+        }
+        if (this->size_ > (this->buckets.size() + this->split_count) * max_bucket_size and this->radix_bits < max_radix_bits) [[unlikely]] {
+            this->grow();
+        }
+        return true;
+    }
+
+    bool CompactHashSet::contains(uint64_t const hash) const noexcept {
+        auto const &bucket = this->bucket_of(hash);
+        return bucket.front_contains(hash) or bucket.compressed_contains(hash);
+    }
+
+    size_t CompactHashSet::memory_usage() const noexcept {
+        size_t bytes = (this->buckets.capacity() + this->split_buckets.capacity()) * sizeof(Bucket);
+        for (auto const *bucket_list : {&this->buckets, &this->split_buckets}) {
+            for (auto const &bucket : *bucket_list) {
+                bytes += bucket.front.capacity() * sizeof(uint64_t) +
+                         bucket.blocks.capacity() * sizeof(BlockHeader) +
+                         bucket.packed_deltas.capacity() * sizeof(uint64_t);
+            }
+        }
+        return bytes;
+    }
+
+}  // namespace rdf4cpp::rdftools::dedup
@@ -0,0 +1,102 @@
+#ifndef RDFTOOLS_COMPACTHASHSET_HPP
+#define RDFTOOLS_COMPACTHASHSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rdf4cpp::rdftools::dedup {
+
+/**
+ * Exact set of 64-bit hashes that needs less memory per entry than a hash table, at the cost of slower inserts.
+ *
+ * Hashes are distributed by their top radix_bits bits into buckets. The number of buckets grows with the set, so that a bucket holds
+ * about max_bucket_size hashes on average. Thus, small sets do not pay for many empty buckets. Like in linear hashing, the set grows
+ * by splitting one bucket at a time at the next bit of the hashes whenever the average exceeds max_bucket_size, so an insert never
+ * has to re-encode more than one bucket. Each bucket consists of
+ *  - a small, sorted, uncompressed front buffer that takes new hashes and
+ *  - a sorted, compressed run: blocks of block_size hashes, each stored as its first hash followed by the bit-packed
+ *    deltas between consecutive hashes. All deltas of a block share the bit width of the largest one.
+ * When the front buffer of a bucket is full, it is merged into the compressed run. The front buffer grows with the run,
+ * so that merging stays amortized constant per inserted hash.
+ *
+ * For n uniformly distributed hashes, an entry costs roughly log2(2^64 / n) + 4 bits, e.g. ~38 bits for 10^9 hashes.
+ *
+ * @note the hashes must be uniformly distributed, e.g. the output of XXH3
+ */
+class CompactHashSet {
+public:
+    static constexpr size_t block_size = 64;
+
+private:
+    static constexpr unsigned initial_radix_bits = 4;
+    static constexpr unsigned max_radix_bits = 24;
+    // average number of hashes per bucket at which the next bucket is split
+    static constexpr size_t max_bucket_size = 4096;
+    static constexpr size_t min_front_capacity = 32;
+    // front buffer holds at most 1/front_capacity_divisor of the compressed run
+    static constexpr size_t front_capacity_divisor = 16;
+
+    struct BlockHeader {
+        uint64_t first;
+        uint32_t bit_offset;
+        uint8_t delta_width;
+        uint8_t size;
+    };
+
+    struct Bucket {
+        std::vector<uint64_t> front;
+        std::vector<BlockHeader> blocks;
+        std::vector<uint64_t> packed_deltas;
+        size_t compressed_size = 0;
+
+        [[nodiscard]] bool front_contains(uint64_t hash) const noexcept;
+        [[nodiscard]] bool compressed_contains(uint64_t hash) const noexcept;
+        void decode_into(std::vector<uint64_t> &out) const;
+        void encode(std::vector<uint64_t> const &sorted);
+        void merge_front();
+        [[nodiscard]] size_t front_capacity() const noexcept;
+        /**
+         * Moves all hashes of this bucket into lower and upper, depending on the given bit.
+         */
+        void split_into(uint64_t bit, Bucket &lower, Bucket &upper) const;
+    };
+
+    unsigned radix_bits;
+    std::vector<Bucket> buckets;
+    // buckets[i] for i < split_count were split into split_buckets[2 * i] and split_buckets[2 * i + 1], which use radix_bits + 1 bits
+    std::vector<Bucket> split_buckets;
+    size_t split_count = 0;
+    size_t size_ = 0;
+
+    [[nodiscard]] Bucket &bucket_of(uint64_t hash) noexcept;
+    [[nodiscard]] Bucket const &bucket_of(uint64_t hash) const noexcept;
+    /**
+     * Splits the next bucket at the next bit of the hashes. After all buckets were split, radix_bits is incremented.
+     */
+    void grow();
+
+public:
+    CompactHashSet();
+
+    /**
+     * Inserts hash, if it is not already contained.
+     * @return true if hash was inserted, false if it was already contained
+     */
+    bool insert(uint64_t hash);
+
+    [[nodiscard]] bool contains(uint64_t hash) const noexcept;
+
+    [[nodiscard]] size_t size() const noexcept {
+        return this->size_;
+    }
+
+    /**
+     * @return approximate number of bytes allocated by the set
+     */
+    [[nodiscard]] size_t memory_usage() const noexcept;
+};
+
+}  // namespace rdf4cpp::rdftools::dedup
+
+#endif  // RDFTOOLS_COMPACTHASHSET_HPP
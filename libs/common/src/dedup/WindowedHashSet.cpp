@@ -0,0 +1,127 @@
+#include <dedup/WindowedHashSet.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace rdf4cpp::rdftools::dedup {
+
+    namespace {
+
+        /**
+         * Capacity of each generation, so that all generations but the current one together hold at least window hashes.
+         */
+        size_t generation_capacity_for(size_t const window, size_t const generations) noexcept {
+            auto const full_generations = std::max(generations, size_t{2}) - 1;
+            return std::max(size_t{1}, (window + full_generations - 1) / full_generations);
+        }
+
+        /**
+         * Maps hash to [0, slots) without division. Multiplying with the golden ratio first spreads hashes that differ only in their lower bits.
+         */
+        size_t home_slot(uint64_t const hash, size_t const slots) noexcept {
+            return static_cast<size_t>((static_cast<unsigned __int128>(hash * 0x9E3779B97F4A7C15ULL) * slots) >> 64);
+        }
+
+        size_t next_slot(size_t const slot, size_t const slots) noexcept {
+            return slot + 1 == slots ? 0 : slot + 1;
+        }
+
+    }  // namespace
+
+    WindowedHashSet::Generation::Generation(size_t const slots)
+        : hashes{std::make_unique<uint64_t[]>(slots)},
+          epochs{std::make_unique<uint8_t[]>(slots)} {
+    }
+
+    bool WindowedHashSet::Generation::contains(uint64_t const hash, size_t const slots) const noexcept {
+        // slots of older epochs are empty. The load factor is at most 1/2, so there is always an empty slot.
+        for (size_t slot = home_slot(hash, slots); this->epochs[slot] == this->epoch; slot = next_slot(slot, slots)) {
+            if (this->hashes[slot] == hash) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void WindowedHashSet::Generation::insert(uint64_t const hash, size_t const slots) noexcept {
+        auto slot = home_slot(hash, slots);
+        while (this->epochs[slot] == this->epoch) {
+            slot = next_slot(slot, slots);
+        }
+        this->hashes[slot] = hash;
+        this->epochs[slot] = this->epoch;
+        ++this->size;
+    }
+
+    void WindowedHashSet::Generation::reset(size_t const slots) noexcept {
+        if (++this->epoch == 0) {
+            // epoch 0 marks slots that were never used
+            std::memset(this->epochs.get(), 0, slots);
+            this->epoch = 1;
+        }
+        this->size = 0;
+    }
+
+    WindowedHashSet::WindowedHashSet(size_t const slots, size_t const generation_capacity, size_t const generations)
+        : slots{slots},
+          generation_capacity{generation_capacity} {
+        if (generations < 2) {
+            throw std::invalid_argument{"WindowedHashSet needs at least 2 generations."};
+        }
+        this->generations.reserve(generations);
+        for (size_t i = 0; i < generations; ++i) {
+            this->generations.emplace_back(slots);
+        }
+    }
+
+    WindowedHashSet::WindowedHashSet(size_t const window, size_t const generations)
+        : WindowedHashSet{2 * generation_capacity_for(window, generations),
+                          generation_capacity_for(window, generations),
+                          generations} {
+        if (window == 0) {
+            throw std::invalid_argument{"The window of a WindowedHashSet must not be empty."};
+        }
+    }
+
+    WindowedHashSet WindowedHashSet::with_memory_budget(size_t const memory_budget, size_t const generations) {
+        auto const slots = memory_budget / std::max(generations, size_t{1}) / bytes_per_slot;
+        if (slots < 2) {
+            throw std::invalid_argument{"The memory budget of a WindowedHashSet is too small."};
+        }
+        return WindowedHashSet{slots, slots / 2, generations};
+    }
+
+    bool WindowedHashSet::insert(uint64_t const hash) {
+        if (this->contains(hash)) {
+            return false;
+        }
+
+        if (this->generations[this->current].size == this->generation_capacity) {
+            this->current = (this->current + 1) % this->generations.size();
+            this->generations[this->current].reset(this->slots);
+        }
+        this->generations[this->current].insert(hash, this->slots);
+        return true;
+    }
+
+    bool WindowedHashSet::contains(uint64_t const hash) const noexcept {
+        // most duplicates are close together, so start with the current generation
+        for (size_t i = 0; i < this->generations.size(); ++i) {
+            auto const &generation = this->generations[(this->current + this->generations.size() - i) % this->generations.size()];
+            if (generation.contains(hash, this->slots)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t WindowedHashSet::size() const noexcept {
+        size_t size = 0;
+        for (auto const &generation : this->generations) {
+            size += generation.size;
+        }
+        return size;
+    }
+
+}  // namespace rdf4cpp::rdftools::dedup
@@ -0,0 +1,94 @@
+#ifndef RDFTOOLS_WINDOWEDHASHSET_HPP
+#define RDFTOOLS_WINDOWEDHASHSET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace rdf4cpp::rdftools::dedup {
+
+/**
+ * Set of 64-bit hashes that only remembers the most recently inserted ones. Suitable for deduplicating unbounded streams
+ * in constant memory.
+ *
+ * The set consists of a fixed number of generations, each an open addressing table of fixed size. New hashes go into the
+ * current generation. When it is full, the oldest generation is dropped and reused as the current one.
+ * Dropping a generation is O(1): each slot is tagged with the epoch of its generation, so bumping the epoch empties all slots
+ * at once. Only when the 8-bit epoch wraps around, the tags are cleared.
+ *
+ * A hash is recognized as duplicate if it was inserted within the last window() insertions. Older hashes may be inserted again.
+ * All memory is allocated on construction.
+ */
+class WindowedHashSet {
+public:
+    static constexpr size_t default_generations = 4;
+
+private:
+    static constexpr size_t bytes_per_slot = sizeof(uint64_t) + sizeof(uint8_t);
+
+    struct Generation {
+        std::unique_ptr<uint64_t[]> hashes;
+        std::unique_ptr<uint8_t[]> epochs;
+        uint8_t epoch = 1;
+        size_t size = 0;
+
+        explicit Generation(size_t slots);
+
+        [[nodiscard]] bool contains(uint64_t hash, size_t slots) const noexcept;
+        void insert(uint64_t hash, size_t slots) noexcept;
+        void reset(size_t slots) noexcept;
+    };
+
+    size_t slots;
+    size_t generation_capacity;
+    std::vector<Generation> generations;
+    size_t current = 0;
+
+    WindowedHashSet(size_t slots, size_t generation_capacity, size_t generations);
+
+public:
+    /**
+     * @param window number of most recent insertions that are guaranteed to be remembered
+     * @param generations number of generations. More generations need less memory beyond window but make lookups slower.
+     * @throws std::invalid_argument if window is 0 or generations is less than 2
+     */
+    explicit WindowedHashSet(size_t window, size_t generations = default_generations);
+
+    /**
+     * Creates a set with the largest window that fits into memory_budget bytes.
+     * @throws std::invalid_argument if memory_budget is too small for a window of at least one hash or generations is less than 2
+     */
+    [[nodiscard]] static WindowedHashSet with_memory_budget(size_t memory_budget, size_t generations = default_generations);
+
+    /**
+     * Inserts hash, if it is not contained.
+     * @return true if hash was inserted, false if it was already contained
+     */
+    bool insert(uint64_t hash);
+
+    [[nodiscard]] bool contains(uint64_t hash) const noexcept;
+
+    /**
+     * @return number of most recent insertions that are guaranteed to be remembered
+     */
+    [[nodiscard]] size_t window() const noexcept {
+        return (this->generations.size() - 1) * this->generation_capacity;
+    }
+
+    /**
+     * @return number of hashes currently remembered. Between window() and window() + the capacity of one generation.
+     */
+    [[nodiscard]] size_t size() const noexcept;
+
+    /**
+     * @return number of bytes allocated by the set
+     */
+    [[nodiscard]] size_t memory_usage() const noexcept {
+        return this->generations.size() * this->slots * bytes_per_slot;
+    }
+};
+
+}  // namespace rdf4cpp::rdftools::dedup
+
+#endif  // RDFTOOLS_WINDOWEDHASHSET_HPP
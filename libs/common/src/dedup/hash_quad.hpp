@@ -0,0 +1,38 @@
+#ifndef RDFTOOLS_HASH_QUAD_HPP
+#define RDFTOOLS_HASH_QUAD_HPP
+
+#include <array>
+#include <cstdint>
+
+#include <xxh3.h>
+
+#include <rdf4cpp/rdf/storage/util/robin-hood-hashing/robin_hood_hash.hpp>
+
+#include <parser/IStreamQuadIterator.hpp>
+
+namespace rdf4cpp::rdftools::dedup {
+
+/**
+ * Hash algorithm with good performance in hashtables
+ */
+using uint64_fast_hash = rdf4cpp::rdf::storage::util::robin_hood::hash<uint64_t>;
+
+/**
+ * Hash the triple part of an rdf4cpp Quad.
+ * @note Hashing happens based on rdf4cpp node handles. rdf4cpp canonized most literals before assigning an handle.
+ * This deduplicates, e.g: "1.0"^^xsd:decimal and "1"^^xsd:decimal
+ * @param quad the quad containing the triple part
+ * @return an hash
+ */
+inline auto hash_quad(rdf4cpp::rdftools::parser::StringQuad const &quad) -> uint64_t {
+    std::array<uint64_t, 4> hashes;
+    for (size_t i = 0UL; i < 4UL; ++i) {
+        auto const val = quad[i].view();
+        hashes[i] = XXH3_64bits(val.begin(), val.size());
+    }
+    return XXH3_64bits(hashes.begin(), sizeof(decltype(hashes)));
+}
+
+}  // namespace rdf4cpp::rdftools::dedup
+
+#endif  // RDFTOOLS_HASH_QUAD_HPP
@@ -0,0 +1,263 @@
+#include <dictionary/DictionaryReader.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+namespace rdf4cpp::rdftools::dictionary {
+
+    namespace {
+
+        auto with_extension(std::filesystem::path path, std::string_view extension) -> std::filesystem::path {
+            path += extension;
+            return path;
+        }
+
+        template<typename T>
+        auto read_pod(std::byte const *pos) noexcept -> T {
+            T value;
+            std::memcpy(&value, pos, sizeof(T));
+            return value;
+        }
+
+        [[noreturn]] void throw_corrupted() {
+            throw std::runtime_error{"dictionary file is corrupted"};
+        }
+
+        auto read_checked_varint(std::byte const *&pos, std::byte const *end) -> uint64_t {
+            auto const value = read_varint(pos, end);
+            if (not value.has_value()) [[unlikely]] {
+                throw_corrupted();
+            }
+            return *value;
+        }
+
+        auto read_bytes(std::byte const *&pos, std::byte const *end, uint64_t len) -> std::string_view {
+            if (static_cast<uint64_t>(end - pos) < len) [[unlikely]] {
+                throw_corrupted();
+            }
+            std::string_view const bytes{reinterpret_cast<char const *>(pos), len};
+            pos += len;
+            return bytes;
+        }
+
+        /**
+         * Decodes the next front-coded term in a block into term, which must hold the previous term of the block.
+         */
+        void decode_next_term(std::byte const *&pos, std::byte const *end, std::string &term) {
+            auto const shared = read_checked_varint(pos, end);
+            auto const suffix_len = read_checked_varint(pos, end);
+            if (shared > term.size()) [[unlikely]] {
+                throw_corrupted();
+            }
+            term.resize(shared);
+            term.append(read_bytes(pos, end, suffix_len));
+        }
+
+    }  // namespace
+
+    /*
+     * Dictionary
+     */
+
+    Dictionary::Dictionary(std::filesystem::path const &path)
+        : file{path} {
+        auto const bytes = this->file.bytes();
+        if (bytes.size() < sizeof(DictionaryHeader)) {
+            throw std::runtime_error{fmt::format("{} is not a dictionary file", path.string())};
+        }
+
+        this->header = read_pod<DictionaryHeader>(bytes.data());
+        if (this->header.magic != dictionary_magic) {
+            throw std::runtime_error{fmt::format("{} is not a dictionary file", path.string())};
+        }
+        if (this->header.version != format_version) {
+            throw std::runtime_error{fmt::format("{} has unsupported format version {}", path.string(), this->header.version)};
+        }
+        if (this->header.block_size == 0 or
+            this->header.block_count != (this->header.term_count + this->header.block_size - 1) / this->header.block_size or
+            (bytes.size() - sizeof(DictionaryHeader)) / sizeof(uint64_t) < this->header.block_count) {
+            throw std::runtime_error{fmt::format("{} has a corrupted header", path.string())};
+        }
+
+        this->block_offsets = bytes.data() + sizeof(DictionaryHeader);
+        this->data_begin = this->block_offsets + this->header.block_count * sizeof(uint64_t);
+        this->data_end = bytes.data() + bytes.size();
+
+        // validated once here, so that block_begin() always points into the data section
+        auto const data_size = static_cast<uint64_t>(this->data_end - this->data_begin);
+        for (uint64_t block = 0; block < this->header.block_count; ++block) {
+            if (read_pod<uint64_t>(this->block_offsets + block * sizeof(uint64_t)) >= data_size) {
+                throw std::runtime_error{fmt::format("{} has a corrupted block offset", path.string())};
+            }
+        }
+    }
+
+    std::byte const *Dictionary::block_begin(uint64_t const block) const noexcept {
+        return this->data_begin + read_pod<uint64_t>(this->block_offsets + block * sizeof(uint64_t));
+    }
+
+    std::string_view Dictionary::first_term_of_block(uint64_t const block) const {
+        auto const *pos = this->block_begin(block);
+        auto const len = read_checked_varint(pos, this->data_end);
+        return read_bytes(pos, this->data_end, len);
+    }
+
+    std::string Dictionary::term(uint64_t const id) const {
+        if (id >= this->size()) {
+            throw std::out_of_range{fmt::format("term id {} is out of range, dictionary has {} terms", id, this->size())};
+        }
+
+        auto const block = id / this->header.block_size;
+        auto const *pos = this->block_begin(block);
+        auto const len = read_checked_varint(pos, this->data_end);
+        std::string term{read_bytes(pos, this->data_end, len)};
+
+        for (auto i = block * this->header.block_size; i < id; ++i) {
+            decode_next_term(pos, this->data_end, term);
+        }
+        return term;
+    }
+
+    void Dictionary::decode_block(uint64_t const block, std::vector<std::string> &terms) const {
+        if (block >= this->header.block_count) {
+            throw std::out_of_range{fmt::format("block {} is out of range, dictionary has {} blocks", block, this->header.block_count)};
+        }
+
+        auto const first_id = block * this->header.block_size;
+        terms.resize(std::min<uint64_t>(this->header.block_size, this->size() - first_id));
+
+        auto const *pos = this->block_begin(block);
+        auto const len = read_checked_varint(pos, this->data_end);
+        terms[0].assign(read_bytes(pos, this->data_end, len));
+        for (size_t i = 1; i < terms.size(); ++i) {
+            terms[i].assign(terms[i - 1]);
+            decode_next_term(pos, this->data_end, terms[i]);
+        }
+    }
+
+    std::optional<uint64_t> Dictionary::find(std::string_view const term) const {
+        if (this->size() == 0) {
+            return std::nullopt;
+        }
+
+        // find the last block whose first term is <= term
+        uint64_t lo = 0;
+        uint64_t hi = this->header.block_count;
+        while (hi - lo > 1) {
+            auto const mid = lo + (hi - lo) / 2;
+            if (this->first_term_of_block(mid) <= term) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+
+        auto const *pos = this->block_begin(lo);
+        auto const len = read_checked_varint(pos, this->data_end);
+        std::string cur{read_bytes(pos, this->data_end, len)};
+
+        auto id = lo * this->header.block_size;
+        auto const block_end = std::min(id + this->header.block_size, this->size());
+        while (true) {
+            if (cur == term) {
+                return id;
+            }
+            if (cur > term or ++id == block_end) {
+                return std::nullopt;
+            }
+            decode_next_term(pos, this->data_end, cur);
+        }
+    }
+
+    /*
+     * IdTriples
+     */
+
+    IdTriples::IdTriples(std::filesystem::path const &path)
+        : file{path} {
+        auto const bytes = this->file.bytes();
+        if (bytes.size() < sizeof(IdTriplesHeader)) {
+            throw std::runtime_error{fmt::format("{} is not an ID triples file", path.string())};
+        }
+
+        this->header = read_pod<IdTriplesHeader>(bytes.data());
+        if (this->header.magic != id_triples_magic) {
+            throw std::runtime_error{fmt::format("{} is not an ID triples file", path.string())};
+        }
+        if (this->header.version != format_version) {
+            throw std::runtime_error{fmt::format("{} has unsupported format version {}", path.string(), this->header.version)};
+        }
+        if ((this->header.id_width != sizeof(uint32_t) and this->header.id_width != sizeof(uint64_t)) or
+            (bytes.size() - sizeof(IdTriplesHeader)) / (3UL * this->header.id_width) < this->header.triple_count) {
+            throw std::runtime_error{fmt::format("{} has a corrupted header", path.string())};
+        }
+
+        this->triples_begin = bytes.data() + sizeof(IdTriplesHeader);
+    }
+
+    IdTriples::id_triple_type IdTriples::operator[](uint64_t const index) const noexcept {
+        auto const *pos = this->triples_begin + index * 3UL * this->header.id_width;
+        if (this->header.id_width == sizeof(uint32_t)) {
+            auto const ids = read_pod<std::array<uint32_t, 3UL>>(pos);
+            return {ids[0], ids[1], ids[2]};
+        } else {
+            return read_pod<id_triple_type>(pos);
+        }
+    }
+
+    /*
+     * DictionaryReader
+     */
+
+    DictionaryReader::DictionaryReader(std::filesystem::path const &path)
+        : dictionary_{with_extension(path, dictionary_file_extension)},
+          id_triples_{with_extension(path, id_triples_file_extension)} {
+    }
+
+    DictionaryReader::iterator DictionaryReader::begin() const {
+        return iterator{*this, 0};
+    }
+
+    DictionaryReader::iterator::iterator(DictionaryReader const &reader, uint64_t const pos)
+        : reader{&reader},
+          pos{pos} {
+        this->decode();
+    }
+
+    void DictionaryReader::iterator::decode() {
+        if (*this == std::default_sentinel) {
+            return;
+        }
+
+        auto const &dictionary = this->reader->dictionary_;
+        auto const ids = this->reader->id_triples_[this->pos];
+        for (size_t i = 0; i < ids.size(); ++i) {
+            if (ids[i] >= dictionary.size()) [[unlikely]] {
+                throw std::out_of_range{fmt::format("term id {} is out of range, dictionary has {} terms", ids[i], dictionary.size())};
+            }
+
+            auto const block = ids[i] / dictionary.block_size();
+            if (auto &cached = this->cache[i]; cached.block != block) {
+                // invalidate first, so that the cache is not left inconsistent if decoding throws
+                cached.block = std::numeric_limits<uint64_t>::max();
+                dictionary.decode_block(block, cached.terms);
+                cached.block = block;
+            }
+            this->cur[i] = this->cache[i].terms[ids[i] % dictionary.block_size()];
+        }
+    }
+
+    DictionaryReader::iterator &DictionaryReader::iterator::operator++() {
+        ++this->pos;
+        this->decode();
+        return *this;
+    }
+
+    bool DictionaryReader::iterator::operator==(std::default_sentinel_t) const noexcept {
+        return this->reader == nullptr || this->pos >= this->reader->size();
+    }
+
+}  // namespace rdf4cpp::rdftools::dictionary
@@ -0,0 +1,180 @@
+#ifndef RDFTOOLS_DICTIONARYREADER_HPP
+#define RDFTOOLS_DICTIONARYREADER_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <dictionary/Format.hpp>
+#include <dictionary/MappedFile.hpp>
+
+namespace rdf4cpp::rdftools::dictionary {
+
+/**
+ * Memory-mapped, front-coded term dictionary (<name>.dict).
+ */
+class Dictionary {
+    MappedFile file;
+    DictionaryHeader header;
+    std::byte const *block_offsets;
+    std::byte const *data_begin;
+    std::byte const *data_end;
+
+    /**
+     * @return start of the block in the data section. The block offsets are checked in the constructor.
+     */
+    [[nodiscard]] std::byte const *block_begin(uint64_t block) const noexcept;
+    [[nodiscard]] std::string_view first_term_of_block(uint64_t block) const;
+
+public:
+    /**
+     * @throws std::runtime_error if the file cannot be mapped, is not a dictionary file or its block offsets are corrupted
+     */
+    explicit Dictionary(std::filesystem::path const &path);
+
+    [[nodiscard]] uint64_t size() const noexcept {
+        return this->header.term_count;
+    }
+
+    [[nodiscard]] uint32_t block_size() const noexcept {
+        return this->header.block_size;
+    }
+
+    /**
+     * Decodes the term with the given ID. Decodes its block from the start, prefer decode_block() to look up many IDs.
+     * @throws std::out_of_range if id >= size()
+     * @throws std::runtime_error if the file is corrupted
+     */
+    [[nodiscard]] std::string term(uint64_t id) const;
+
+    /**
+     * Decodes all terms of a block. The term with ID id is in block id / block_size() at position id % block_size().
+     * @param terms is overwritten with the terms of the block; its strings are reused
+     * @throws std::out_of_range if block is not a block of the dictionary
+     * @throws std::runtime_error if the file is corrupted
+     */
+    void decode_block(uint64_t block, std::vector<std::string> &terms) const;
+
+    /**
+     * Looks up the ID of an N-Triples encoded term.
+     * @return the ID or std::nullopt if term is not in the dictionary
+     */
+    [[nodiscard]] std::optional<uint64_t> find(std::string_view term) const;
+};
+
+/**
+ * Memory-mapped array of fixed-width ID triples (<name>.ids).
+ */
+class IdTriples {
+    MappedFile file;
+    IdTriplesHeader header;
+    std::byte const *triples_begin;
+
+public:
+    using id_triple_type = std::array<uint64_t, 3UL>;
+
+    /**
+     * @throws std::runtime_error if the file cannot be mapped or is not an ID triples file
+     */
+    explicit IdTriples(std::filesystem::path const &path);
+
+    [[nodiscard]] uint64_t size() const noexcept {
+        return this->header.triple_count;
+    }
+
+    [[nodiscard]] uint32_t id_width() const noexcept {
+        return this->header.id_width;
+    }
+
+    /**
+     * @warning index is not bounds checked
+     */
+    [[nodiscard]] id_triple_type operator[](uint64_t index) const noexcept;
+};
+
+/**
+ * Streams back a dataset that was written by DictionaryWriter.
+ *
+ * @example
+ * @code
+ * DictionaryReader reader{"dataset"}; // reads dataset.dict and dataset.ids
+ * for (auto const &[s, p, o] : reader) {
+ *      std::cout << s << ' ' << p << ' ' << o << " .\n";
+ * }
+ * @endcode
+ */
+class DictionaryReader {
+    Dictionary dictionary_;
+    IdTriples id_triples_;
+
+public:
+    /**
+     * Similar to std::istream_iterator<>. Decodes the triple at the current position when it is advanced.
+     * The most recently decoded block of each triple position is cached, so that runs of triples with the same subject
+     * or predicate decode their blocks only once.
+     */
+    struct iterator {
+        using value_type = StringTriple;
+        using reference = value_type const &;
+        using pointer = value_type const *;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::input_iterator_tag;
+
+    private:
+        struct CachedBlock {
+            uint64_t block = std::numeric_limits<uint64_t>::max();
+            std::vector<std::string> terms;
+        };
+
+        DictionaryReader const *reader = nullptr;
+        uint64_t pos = 0;
+        value_type cur;
+        std::array<CachedBlock, 3UL> cache;
+
+        void decode();
+
+    public:
+        iterator() noexcept = default;
+        iterator(DictionaryReader const &reader, uint64_t pos);
+
+        reference operator*() const noexcept { return this->cur; }
+        pointer operator->() const noexcept { return &this->cur; }
+        iterator &operator++();
+
+        bool operator==(std::default_sentinel_t) const noexcept;
+    };
+
+    /**
+     * @param path path without extension; <path>.dict and <path>.ids are read
+     * @throws std::runtime_error if either file cannot be mapped or is malformed
+     */
+    explicit DictionaryReader(std::filesystem::path const &path);
+
+    [[nodiscard]] Dictionary const &dictionary() const noexcept {
+        return this->dictionary_;
+    }
+
+    [[nodiscard]] IdTriples const &id_triples() const noexcept {
+        return this->id_triples_;
+    }
+
+    [[nodiscard]] uint64_t size() const noexcept {
+        return this->id_triples_.size();
+    }
+
+    [[nodiscard]] iterator begin() const;
+
+    [[nodiscard]] std::default_sentinel_t end() const noexcept {
+        return std::default_sentinel;
+    }
+};
+
+}  // namespace rdf4cpp::rdftools::dictionary
+
+#endif  // RDFTOOLS_DICTIONARYREADER_HPP
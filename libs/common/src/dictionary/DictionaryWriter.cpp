@@ -0,0 +1,463 @@
+#include <dictionary/DictionaryWriter.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace rdf4cpp::rdftools::dictionary {
+
+    namespace {
+
+        auto with_extension(std::filesystem::path path, std::string_view extension) -> std::filesystem::path {
+            path += extension;
+            return path;
+        }
+
+        template<typename T>
+        void write_pod(std::ostream &os, T const &value) {
+            os.write(reinterpret_cast<char const *>(&value), sizeof(T));
+        }
+
+        /**
+         * Number of leading bytes that a and b have in common.
+         */
+        auto common_prefix_length(std::string_view a, std::string_view b) noexcept -> size_t {
+            auto const [a_end, _] = std::mismatch(a.begin(), a.begin() + static_cast<std::ptrdiff_t>(std::min(a.size(), b.size())), b.begin());
+            return static_cast<size_t>(a_end - a.begin());
+        }
+
+        /**
+         * Front-codes terms, which must be passed in sorted order and without duplicates, into a data section.
+         */
+        class FrontCoder {
+            std::ostream &os;
+            uint32_t block_size;
+            std::vector<uint64_t> block_offsets_;
+            std::string buffer;
+            std::string prev_;
+            uint64_t size_ = 0;
+            uint64_t data_offset = 0;
+
+        public:
+            FrontCoder(std::ostream &os, uint32_t block_size) noexcept
+                : os{os},
+                  block_size{block_size} {
+            }
+
+            void add(std::string_view const term) {
+                this->buffer.clear();
+                if (this->size_ % this->block_size == 0) {
+                    this->block_offsets_.push_back(this->data_offset);
+                    append_varint(this->buffer, term.size());
+                    this->buffer.append(term);
+                } else {
+                    auto const shared = common_prefix_length(this->prev_, term);
+                    append_varint(this->buffer, shared);
+                    append_varint(this->buffer, term.size() - shared);
+                    this->buffer.append(term.substr(shared));
+                }
+                this->os.write(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+                this->data_offset += this->buffer.size();
+                this->prev_.assign(term);
+                ++this->size_;
+            }
+
+            [[nodiscard]] std::string_view prev() const noexcept {
+                return this->prev_;
+            }
+
+            [[nodiscard]] uint64_t size() const noexcept {
+                return this->size_;
+            }
+
+            [[nodiscard]] std::vector<uint64_t> const &block_offsets() const noexcept {
+                return this->block_offsets_;
+            }
+        };
+
+        /**
+         * Reads the (term, provisional ID) records of a run that was written by DictionaryWriter::spill_run().
+         */
+        class RunReader {
+            std::filesystem::path path;
+            std::ifstream in;
+            std::string term_;
+            uint64_t id_ = 0;
+
+        public:
+            explicit RunReader(std::filesystem::path run_path)
+                : path{std::move(run_path)},
+                  in{this->path, std::ios::binary} {
+                if (not this->in.is_open()) {
+                    throw std::runtime_error{fmt::format("unable to open temporary file {}", this->path.string())};
+                }
+            }
+
+            /**
+             * Reads the next record.
+             * @return false at the end of the run
+             */
+            bool next() {
+                uint64_t len;
+                if (not this->in.read(reinterpret_cast<char *>(&len), sizeof(len))) {
+                    if (this->in.gcount() == 0 and this->in.eof()) {
+                        return false;
+                    }
+                    throw std::runtime_error{fmt::format("unable to read temporary file {}", this->path.string())};
+                }
+                this->term_.resize(len);
+                this->in.read(this->term_.data(), static_cast<std::streamsize>(len));
+                this->in.read(reinterpret_cast<char *>(&this->id_), sizeof(this->id_));
+                if (not this->in) {
+                    throw std::runtime_error{fmt::format("unable to read temporary file {}", this->path.string())};
+                }
+                return true;
+            }
+
+            [[nodiscard]] std::string_view term() const noexcept {
+                return this->term_;
+            }
+
+            [[nodiscard]] uint64_t id() const noexcept {
+                return this->id_;
+            }
+        };
+
+        void write_run_record(std::ostream &os, std::string_view const term, uint64_t const id) {
+            write_pod(os, static_cast<uint64_t>(term.size()));
+            os.write(term.data(), static_cast<std::streamsize>(term.size()));
+            write_pod(os, id);
+        }
+
+        /**
+         * Merges sorted runs and calls on_record(term, id) for each record in term order.
+         */
+        template<typename F>
+        void merge_runs(std::span<std::filesystem::path const> const run_paths, F &&on_record) {
+            std::vector<RunReader> runs;
+            runs.reserve(run_paths.size());
+            for (auto const &run_path : run_paths) {
+                runs.emplace_back(run_path);
+            }
+
+            auto const greater_term = [&runs](size_t const lhs, size_t const rhs) {
+                return runs[lhs].term() > runs[rhs].term();
+            };
+            std::priority_queue<size_t, std::vector<size_t>, decltype(greater_term)> heads{greater_term};
+            for (size_t run = 0; run < runs.size(); ++run) {
+                if (runs[run].next()) {
+                    heads.push(run);
+                }
+            }
+
+            while (not heads.empty()) {
+                auto const run = heads.top();
+                heads.pop();
+                on_record(runs[run].term(), runs[run].id());
+                if (runs[run].next()) {
+                    heads.push(run);
+                }
+            }
+        }
+
+        /**
+         * Approximate memory that a distinct term occupies in a run, including the index entry.
+         */
+        constexpr size_t run_memory_of(std::string_view const term) noexcept {
+            return term.size() + sizeof(std::string) + sizeof(std::string_view) + sizeof(uint64_t);
+        }
+
+    }  // namespace
+
+    DictionaryWriter::DictionaryWriter(std::filesystem::path const &output_path, uint32_t block_size, size_t memory_limit)
+        : dictionary_path{with_extension(output_path, dictionary_file_extension)},
+          id_triples_path{with_extension(output_path, id_triples_file_extension)},
+          tmp_id_triples_path{with_extension(output_path, std::string{id_triples_file_extension} + ".tmp")},
+          block_size{std::max(block_size, 1U)},
+          memory_limit{memory_limit},
+          tmp_id_triples{tmp_id_triples_path, std::ios::binary | std::ios::trunc} {
+
+        if (not this->tmp_id_triples.is_open()) {
+            throw std::runtime_error{fmt::format("unable to create temporary file {}", this->tmp_id_triples_path.string())};
+        }
+    }
+
+    DictionaryWriter::~DictionaryWriter() noexcept {
+        if (not this->finished) {
+            this->tmp_id_triples.close();
+            std::error_code ec;
+            std::filesystem::remove(this->tmp_id_triples_path, ec);
+            std::filesystem::remove(with_extension(this->dictionary_path, ".data.tmp"), ec);
+            for (auto const &run_path : this->run_paths) {
+                std::filesystem::remove(run_path, ec);
+            }
+        }
+    }
+
+    uint64_t DictionaryWriter::intern(std::string_view const term) {
+        if (auto const it = this->term_ids.find(term); it != this->term_ids.end()) {
+            return it->second;
+        }
+
+        if (this->run_memory >= this->memory_limit) [[unlikely]] {
+            this->spill_run();
+        }
+
+        uint64_t const id = this->term_count++;
+        auto const &stored = this->terms.emplace_back(term);
+        this->term_ids.emplace(std::string_view{stored}, id);
+        this->run_memory += run_memory_of(term);
+        return id;
+    }
+
+    std::vector<uint64_t> DictionaryWriter::sorted_run() const {
+        std::vector<uint64_t> sorted(this->terms.size());
+        std::iota(sorted.begin(), sorted.end(), this->run_begin);
+        std::sort(sorted.begin(), sorted.end(), [this](uint64_t const lhs, uint64_t const rhs) {
+            return std::string_view{this->terms[lhs - this->run_begin]} < std::string_view{this->terms[rhs - this->run_begin]};
+        });
+        return sorted;
+    }
+
+    std::filesystem::path const &DictionaryWriter::new_run_path() {
+        return this->run_paths.emplace_back(with_extension(this->dictionary_path, fmt::format(".run{}.tmp", this->runs_created++)));
+    }
+
+    void DictionaryWriter::spill_run() {
+        auto const &run_path = this->new_run_path();
+        std::ofstream ofs{run_path, std::ios::binary | std::ios::trunc};
+        if (not ofs.is_open()) {
+            throw std::runtime_error{fmt::format("unable to create temporary file {}", run_path.string())};
+        }
+
+        for (auto const id : this->sorted_run()) {
+            write_run_record(ofs, this->terms[id - this->run_begin], id);
+        }
+
+        ofs.close();
+        if (not ofs) {
+            throw std::runtime_error{fmt::format("unable to write to temporary file {}", run_path.string())};
+        }
+        this->clear_run();
+    }
+
+    void DictionaryWriter::reduce_runs() {
+        while (this->run_paths.size() > max_merge_fan_in) {
+            // the merged runs stay in run_paths until they are deleted, so that the destructor cleans up after errors
+            std::vector<std::filesystem::path> const merged(this->run_paths.begin(), this->run_paths.begin() + max_merge_fan_in);
+
+            auto const &run_path = this->new_run_path();
+            std::ofstream ofs{run_path, std::ios::binary | std::ios::trunc};
+            if (not ofs.is_open()) {
+                throw std::runtime_error{fmt::format("unable to create temporary file {}", run_path.string())};
+            }
+            merge_runs(merged, [&ofs](std::string_view const term, uint64_t const id) {
+                write_run_record(ofs, term, id);
+            });
+            ofs.close();
+            if (not ofs) {
+                throw std::runtime_error{fmt::format("unable to write to temporary file {}", run_path.string())};
+            }
+
+            for (auto const &merged_path : merged) {
+                std::filesystem::remove(merged_path);
+            }
+            this->run_paths.erase(this->run_paths.begin(), this->run_paths.begin() + max_merge_fan_in);
+        }
+    }
+
+    void DictionaryWriter::clear_run() {
+        this->term_ids = term_index_type{};
+        std::deque<std::string>{}.swap(this->terms);
+        this->run_memory = 0;
+        this->run_begin = this->term_count;
+    }
+
+    void DictionaryWriter::add(std::string_view const subject, std::string_view const predicate, std::string_view const object) {
+        std::array<uint64_t, 3UL> const ids{this->intern(subject), this->intern(predicate), this->intern(object)};
+        write_pod(this->tmp_id_triples, ids);
+        if (not this->tmp_id_triples) [[unlikely]] {
+            throw std::runtime_error{fmt::format("unable to write to temporary file {}", this->tmp_id_triples_path.string())};
+        }
+        ++this->triple_count;
+    }
+
+    std::vector<uint64_t> DictionaryWriter::write_dictionary() {
+        if (not this->run_paths.empty()) {
+            return this->write_merged_dictionary();
+        }
+
+        auto const sorted = this->sorted_run();
+
+        std::ofstream ofs{this->dictionary_path, std::ios::binary | std::ios::trunc};
+        if (not ofs.is_open()) {
+            throw std::runtime_error{fmt::format("unable to open output file {}", this->dictionary_path.string())};
+        }
+
+        DictionaryHeader const header{
+                .magic = dictionary_magic,
+                .version = format_version,
+                .block_size = this->block_size,
+                .term_count = sorted.size(),
+                .block_count = (sorted.size() + this->block_size - 1) / this->block_size};
+        write_pod(ofs, header);
+
+        // reserve space for the block offsets, they are filled in after the data section was written
+        ofs.seekp(static_cast<std::streamoff>(header.block_count * sizeof(uint64_t)), std::ios::cur);
+
+        std::vector<uint64_t> final_ids(sorted.size());
+        FrontCoder coder{ofs, this->block_size};
+        for (uint64_t final_id = 0; final_id < sorted.size(); ++final_id) {
+            final_ids[sorted[final_id]] = final_id;
+            coder.add(this->terms[sorted[final_id]]);
+        }
+
+        ofs.seekp(sizeof(DictionaryHeader));
+        ofs.write(reinterpret_cast<char const *>(coder.block_offsets().data()),
+                  static_cast<std::streamsize>(coder.block_offsets().size() * sizeof(uint64_t)));
+        ofs.close();
+        if (not ofs) {
+            throw std::runtime_error{fmt::format("unable to write output file {}", this->dictionary_path.string())};
+        }
+
+        return final_ids;
+    }
+
+    std::vector<uint64_t> DictionaryWriter::write_merged_dictionary() {
+        if (not this->terms.empty()) {
+            this->spill_run();
+        }
+        this->reduce_runs();
+
+        // the number of distinct terms is only known after the merge, so the data section goes to a temporary file first
+        auto const data_path = with_extension(this->dictionary_path, ".data.tmp");
+        std::vector<uint64_t> final_ids(this->term_count);
+        std::vector<uint64_t> block_offsets;
+        uint64_t distinct_terms;
+        {
+            std::ofstream data{data_path, std::ios::binary | std::ios::trunc};
+            if (not data.is_open()) {
+                throw std::runtime_error{fmt::format("unable to create temporary file {}", data_path.string())};
+            }
+
+            FrontCoder coder{data, this->block_size};
+            merge_runs(this->run_paths, [&coder, &final_ids](std::string_view const term, uint64_t const id) {
+                if (coder.size() == 0 or coder.prev() != term) {
+                    coder.add(term);
+                }
+                final_ids[id] = coder.size() - 1;
+            });
+
+            data.close();
+            if (not data) {
+                throw std::runtime_error{fmt::format("unable to write to temporary file {}", data_path.string())};
+            }
+            distinct_terms = coder.size();
+            block_offsets = coder.block_offsets();
+        }
+
+        std::ofstream ofs{this->dictionary_path, std::ios::binary | std::ios::trunc};
+        std::ifstream data{data_path, std::ios::binary};
+        if (not ofs.is_open() or not data.is_open()) {
+            throw std::runtime_error{fmt::format("unable to open output file {}", this->dictionary_path.string())};
+        }
+
+        DictionaryHeader const header{
+                .magic = dictionary_magic,
+                .version = format_version,
+                .block_size = this->block_size,
+                .term_count = distinct_terms,
+                .block_count = block_offsets.size()};
+        write_pod(ofs, header);
+        ofs.write(reinterpret_cast<char const *>(block_offsets.data()),
+                  static_cast<std::streamsize>(block_offsets.size() * sizeof(uint64_t)));
+        // runs are only spilled when they hold terms, so the data section is never empty here
+        ofs << data.rdbuf();
+        ofs.close();
+        if (not ofs) {
+            throw std::runtime_error{fmt::format("unable to write output file {}", this->dictionary_path.string())};
+        }
+
+        data.close();
+        std::filesystem::remove(data_path);
+        for (auto const &run_path : this->run_paths) {
+            std::filesystem::remove(run_path);
+        }
+        this->run_paths.clear();
+
+        return final_ids;
+    }
+
+    void DictionaryWriter::write_id_triples(std::vector<uint64_t> const &final_ids) {
+        std::ifstream ifs{this->tmp_id_triples_path, std::ios::binary};
+        std::ofstream ofs{this->id_triples_path, std::ios::binary | std::ios::trunc};
+        if (not ifs.is_open() or not ofs.is_open()) {
+            throw std::runtime_error{fmt::format("unable to open output file {}", this->id_triples_path.string())};
+        }
+
+        // with spilled runs there are more provisional than final IDs, so the width depends on the largest final ID
+        auto const max_id = final_ids.empty() ? 0UL : *std::max_element(final_ids.begin(), final_ids.end());
+        uint32_t const id_width = max_id < std::numeric_limits<uint32_t>::max() ? sizeof(uint32_t) : sizeof(uint64_t);
+        IdTriplesHeader const header{
+                .magic = id_triples_magic,
+                .version = format_version,
+                .id_width = id_width,
+                .triple_count = this->triple_count};
+        write_pod(ofs, header);
+
+        static constexpr size_t chunk_ids = 3UL * 4096UL;
+        std::vector<uint64_t> in_chunk(chunk_ids);
+        std::vector<uint32_t> narrow_chunk(id_width == sizeof(uint32_t) ? chunk_ids : 0UL);
+        while (ifs) {
+            ifs.read(reinterpret_cast<char *>(in_chunk.data()), static_cast<std::streamsize>(chunk_ids * sizeof(uint64_t)));
+            auto const n_ids = static_cast<size_t>(ifs.gcount()) / sizeof(uint64_t);
+
+            if (id_width == sizeof(uint32_t)) {
+                for (size_t i = 0; i < n_ids; ++i) {
+                    narrow_chunk[i] = static_cast<uint32_t>(final_ids[in_chunk[i]]);
+                }
+                ofs.write(reinterpret_cast<char const *>(narrow_chunk.data()), static_cast<std::streamsize>(n_ids * sizeof(uint32_t)));
+            } else {
+                for (size_t i = 0; i < n_ids; ++i) {
+                    in_chunk[i] = final_ids[in_chunk[i]];
+                }
+                ofs.write(reinterpret_cast<char const *>(in_chunk.data()), static_cast<std::streamsize>(n_ids * sizeof(uint64_t)));
+            }
+        }
+
+        ofs.close();
+        if (not ofs) {
+            throw std::runtime_error{fmt::format("unable to write output file {}", this->id_triples_path.string())};
+        }
+    }
+
+    void DictionaryWriter::finish() {
+        if (this->finished) {
+            return;
+        }
+
+        this->tmp_id_triples.close();
+        if (not this->tmp_id_triples) {
+            throw std::runtime_error{fmt::format("unable to write to temporary file {}", this->tmp_id_triples_path.string())};
+        }
+
+        auto const final_ids = this->write_dictionary();
+
+        // the terms are not needed anymore, free memory before remapping the triples
+        this->clear_run();
+
+        this->write_id_triples(final_ids);
+
+        std::filesystem::remove(this->tmp_id_triples_path);
+        this->finished = true;
+    }
+
+}  // namespace rdf4cpp::rdftools::dictionary
@@ -0,0 +1,128 @@
+#ifndef RDFTOOLS_DICTIONARYWRITER_HPP
+#define RDFTOOLS_DICTIONARYWRITER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <rdf4cpp/rdf/storage/util/robin-hood-hashing/robin_hood_hash.hpp>
+#include <rdf4cpp/rdf/storage/util/tsl/sparse_map.h>
+
+#include <dictionary/Format.hpp>
+
+namespace rdf4cpp::rdftools::dictionary {
+
+/**
+ * Writes triples in the dictionary-encoded format described in dictionary/Format.hpp.
+ *
+ * Terms are assigned provisional IDs in order of appearance and the provisional ID triples are streamed to a temporary file.
+ * When the distinct terms held in memory exceed memory_limit bytes, they are written as a sorted run to a temporary file and
+ * forgotten. finish() merges the runs, front-codes the dictionary and rewrites the ID triples with the final IDs.
+ * A term that appears in several runs has a provisional ID per run, all of which are mapped to the same final ID.
+ *
+ * Besides the current run, finish() keeps 8 bytes per provisional ID and 8 bytes per block of the dictionary in memory.
+ *
+ * @example
+ * @code
+ * DictionaryWriter writer{"dataset"}; // writes dataset.dict and dataset.ids
+ * writer.add("<http://a>", "<http://b>", "\"c\"");
+ * writer.finish();
+ * @endcode
+ */
+class DictionaryWriter {
+    using term_index_type = rdf4cpp::rdf::storage::util::tsl::sparse_map<
+            std::string_view,
+            uint64_t,
+            rdf4cpp::rdf::storage::util::robin_hood::hash<std::string_view>>;
+
+    std::filesystem::path dictionary_path;
+    std::filesystem::path id_triples_path;
+    std::filesystem::path tmp_id_triples_path;
+    static constexpr size_t max_merge_fan_in = 64;
+
+    uint32_t block_size;
+    size_t memory_limit;
+
+    // terms of the current run, terms[i] has the provisional ID run_begin + i.
+    // deque, so that the views in term_ids stay valid when terms grows
+    std::deque<std::string> terms;
+    term_index_type term_ids;
+    size_t run_memory = 0;
+    uint64_t run_begin = 0;
+    std::vector<std::filesystem::path> run_paths;
+    uint64_t runs_created = 0;
+    std::ofstream tmp_id_triples;
+    uint64_t term_count = 0;
+    uint64_t triple_count = 0;
+    bool finished = false;
+
+    uint64_t intern(std::string_view term);
+
+    /**
+     * @return provisional IDs of the current run, ordered by their terms
+     */
+    [[nodiscard]] std::vector<uint64_t> sorted_run() const;
+
+    /**
+     * Writes the current run as sorted (term, provisional ID) records to a temporary file and clears it.
+     */
+    void spill_run();
+    void clear_run();
+    std::filesystem::path const &new_run_path();
+    /**
+     * Merges runs into larger ones until at most max_merge_fan_in are left, so that the final merge does not open too many files.
+     */
+    void reduce_runs();
+
+    /**
+     * Writes the sorted, front-coded dictionary.
+     * @return mapping from provisional to final IDs
+     */
+    std::vector<uint64_t> write_dictionary();
+    std::vector<uint64_t> write_merged_dictionary();
+    void write_id_triples(std::vector<uint64_t> const &final_ids);
+
+public:
+    static constexpr size_t default_memory_limit = 1UL << 30;
+
+    /**
+     * @param output_path path without extension; <output_path>.dict and <output_path>.ids are created
+     * @param block_size number of terms per front-coded block
+     * @param memory_limit approximate number of bytes of distinct terms that are held in memory before they are spilled to disk
+     * @throws std::runtime_error if the temporary ID file cannot be created
+     */
+    explicit DictionaryWriter(std::filesystem::path const &output_path, uint32_t block_size = default_block_size,
+                              size_t memory_limit = default_memory_limit);
+
+    DictionaryWriter(DictionaryWriter const &) = delete;
+    DictionaryWriter &operator=(DictionaryWriter const &) = delete;
+    ~DictionaryWriter() noexcept;
+
+    /**
+     * Adds a triple. Terms must be N-Triples encoded.
+     * @throws std::runtime_error on write errors
+     */
+    void add(std::string_view subject, std::string_view predicate, std::string_view object);
+
+    /**
+     * Writes the dictionary and the ID triples. Must be called exactly once after the last add().
+     * @throws std::runtime_error on write errors
+     */
+    void finish();
+
+    [[nodiscard]] uint64_t num_terms() const noexcept {
+        return this->term_count;
+    }
+
+    [[nodiscard]] uint64_t num_triples() const noexcept {
+        return this->triple_count;
+    }
+};
+
+}  // namespace rdf4cpp::rdftools::dictionary
+
+#endif  // RDFTOOLS_DICTIONARYWRITER_HPP
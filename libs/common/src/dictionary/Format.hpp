@@ -0,0 +1,99 @@
+#ifndef RDFTOOLS_DICTIONARY_FORMAT_HPP
+#define RDFTOOLS_DICTIONARY_FORMAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * Dictionary-encoded triple format.
+ *
+ * A dataset is stored as two files next to each other: a term dictionary (<name>.dict) and a file of
+ * fixed-width ID triples (<name>.ids). All integers are stored in host byte order (little-endian on all supported platforms).
+ *
+ * Dictionary file (<name>.dict):
+ *   offset 0   char[8]    magic "RDFTDICT"
+ *   offset 8   uint32     format version
+ *   offset 12  uint32     block size B (terms per block)
+ *   offset 16  uint64     number of terms
+ *   offset 24  uint64     number of blocks
+ *   offset 32  uint64[]   byte offset of each block, relative to the start of the data section
+ *   ...        data section
+ *
+ *   Terms are N-Triples encoded, sorted bytewise and front-coded in blocks of B terms. The first term of a block is stored
+ *   as varint(length) followed by its bytes. Every further term is stored as varint(shared prefix length with the previous term),
+ *   varint(suffix length) followed by the suffix bytes. Varints are unsigned LEB128.
+ *   The ID of a term is its 0-based position in the sorted dictionary.
+ *
+ * ID file (<name>.ids):
+ *   offset 0   char[8]    magic "RDFTIDS\0"
+ *   offset 8   uint32     format version
+ *   offset 12  uint32     ID width W in bytes (4 or 8)
+ *   offset 16  uint64     number of triples
+ *   offset 24  triples    subject, predicate, object ID, W bytes each
+ *
+ *   The triple section is aligned to W, so a memory-mapped ID file can be read as a plain array of uint32_t or uint64_t.
+ */
+namespace rdf4cpp::rdftools::dictionary {
+
+using StringTriple = std::array<std::string, 3UL>;
+
+inline constexpr uint32_t format_version = 1;
+inline constexpr uint32_t default_block_size = 16;
+
+inline constexpr std::array<char, 8> dictionary_magic{'R', 'D', 'F', 'T', 'D', 'I', 'C', 'T'};
+inline constexpr std::array<char, 8> id_triples_magic{'R', 'D', 'F', 'T', 'I', 'D', 'S', '\0'};
+
+inline constexpr std::string_view dictionary_file_extension = ".dict";
+inline constexpr std::string_view id_triples_file_extension = ".ids";
+
+struct DictionaryHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t block_size;
+    uint64_t term_count;
+    uint64_t block_count;
+};
+static_assert(sizeof(DictionaryHeader) == 32);
+
+struct IdTriplesHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t id_width;
+    uint64_t triple_count;
+};
+static_assert(sizeof(IdTriplesHeader) == 24);
+
+/**
+ * Appends value as unsigned LEB128 varint to out.
+ */
+inline void append_varint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+/**
+ * Reads an unsigned LEB128 varint from [pos, end) and advances pos behind it.
+ * @return the value or std::nullopt if the varint is truncated or longer than 64 bit
+ */
+inline std::optional<uint64_t> read_varint(std::byte const *&pos, std::byte const *end) noexcept {
+    uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64 && pos != end; shift += 7) {
+        auto const byte = static_cast<uint8_t>(*pos++);
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return value;
+        }
+    }
+    return std::nullopt;
+}
+
+}  // namespace rdf4cpp::rdftools::dictionary
+
+#endif  // RDFTOOLS_DICTIONARY_FORMAT_HPP
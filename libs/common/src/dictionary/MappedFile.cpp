@@ -0,0 +1,64 @@
+#include <dictionary/MappedFile.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace rdf4cpp::rdftools::dictionary {
+
+MappedFile::MappedFile(std::filesystem::path const &path) {
+    int const fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error{fmt::format("unable to open {}: {}", path.string(), std::strerror(errno))};
+    }
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        auto const err = errno;
+        ::close(fd);
+        throw std::runtime_error{fmt::format("unable to stat {}: {}", path.string(), std::strerror(err))};
+    }
+
+    this->size_ = static_cast<size_t>(st.st_size);
+    if (this->size_ > 0) {
+        this->data_ = ::mmap(nullptr, this->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (this->data_ == MAP_FAILED) {
+            auto const err = errno;
+            ::close(fd);
+            throw std::runtime_error{fmt::format("unable to map {}: {}", path.string(), std::strerror(err))};
+        }
+    }
+    ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)} {
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+    if (this != &other) {
+        if (this->data_ != nullptr) {
+            ::munmap(this->data_, this->size_);
+        }
+        this->data_ = std::exchange(other.data_, nullptr);
+        this->size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() noexcept {
+    if (this->data_ != nullptr) {
+        ::munmap(this->data_, this->size_);
+    }
+}
+
+}  // namespace rdf4cpp::rdftools::dictionary
@@ -0,0 +1,42 @@
+#ifndef RDFTOOLS_MAPPEDFILE_HPP
+#define RDFTOOLS_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace rdf4cpp::rdftools::dictionary {
+
+/**
+ * Read-only memory mapping of a whole file.
+ * @note only works on POSIX
+ */
+class MappedFile {
+    void *data_ = nullptr;
+    size_t size_ = 0;
+
+public:
+    /**
+     * Maps the file at path.
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(std::filesystem::path const &path);
+
+    MappedFile(MappedFile const &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile const &) = delete;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    ~MappedFile() noexcept;
+
+    [[nodiscard]] std::span<std::byte const> bytes() const noexcept {
+        return {static_cast<std::byte const *>(this->data_), this->size_};
+    }
+
+    [[nodiscard]] size_t size() const noexcept {
+        return this->size_;
+    }
+};
+
+}  // namespace rdf4cpp::rdftools::dictionary
+
+#endif  // RDFTOOLS_MAPPEDFILE_HPP
@@ -0,0 +1,62 @@
+#include <io/FileRange.hpp>
+
+#include <algorithm>
+#include <limits>
+
+namespace rdf4cpp::rdftools::io {
+
+    std::vector<FileRange> split_at_line_breaks(std::filesystem::path const &path, size_t const n) {
+        auto const size = static_cast<uint64_t>(std::filesystem::file_size(path));
+
+        std::vector<FileRange> ranges;
+        std::ifstream ifs{path, std::ios::binary};
+        uint64_t begin = 0;
+        for (size_t i = 1; i < std::max(n, size_t{1}) and begin < size; ++i) {
+            auto const target = std::max(begin, size * i / n);
+
+            // the range ends right after the first line break at or after target
+            ifs.clear();
+            ifs.seekg(static_cast<std::streamoff>(target));
+            ifs.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            auto const end = ifs ? static_cast<uint64_t>(ifs.tellg()) : size;
+
+            if (end > begin) {
+                ranges.push_back(FileRange{.path = path, .begin = begin, .end = end});
+                begin = end;
+            }
+        }
+        if (begin < size or ranges.empty()) {
+            ranges.push_back(FileRange{.path = path, .begin = begin, .end = size});
+        }
+        return ranges;
+    }
+
+    FileRangeStreambuf::FileRangeStreambuf(FileRange const &range)
+        : remaining{range.end - range.begin},
+          buffer{std::make_unique<char[]>(buffer_size)} {
+        if (this->file.open(range.path, std::ios::in | std::ios::binary) != nullptr) {
+            this->file.pubseekpos(static_cast<std::streamoff>(range.begin), std::ios::in);
+        }
+    }
+
+    FileRangeStreambuf::int_type FileRangeStreambuf::underflow() {
+        if (this->gptr() < this->egptr()) {
+            return traits_type::to_int_type(*this->gptr());
+        }
+        if (this->remaining == 0 or not this->file.is_open()) {
+            return traits_type::eof();
+        }
+
+        auto const to_read = static_cast<std::streamsize>(std::min<uint64_t>(buffer_size, this->remaining));
+        auto const n = this->file.sgetn(this->buffer.get(), to_read);
+        if (n <= 0) {
+            this->remaining = 0;
+            return traits_type::eof();
+        }
+        this->remaining -= static_cast<uint64_t>(n);
+
+        this->setg(this->buffer.get(), this->buffer.get(), this->buffer.get() + n);
+        return traits_type::to_int_type(*this->gptr());
+    }
+
+}  // namespace rdf4cpp::rdftools::io
@@ -0,0 +1,69 @@
+#ifndef RDFTOOLS_FILERANGE_HPP
+#define RDFTOOLS_FILERANGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <vector>
+
+namespace rdf4cpp::rdftools::io {
+
+/**
+ * Byte range [begin, end) of a file.
+ */
+struct FileRange {
+    std::filesystem::path path;
+    uint64_t begin;
+    uint64_t end;
+};
+
+/**
+ * Splits a file into at most n ranges of similar size. Each range except the first starts right after a line break.
+ * @note Useful for line-based formats like N-Triples where each line can be parsed independently.
+ * @throws std::filesystem::filesystem_error if the file size cannot be determined
+ */
+std::vector<FileRange> split_at_line_breaks(std::filesystem::path const &path, size_t n);
+
+/**
+ * Input streambuf that reads only a FileRange.
+ */
+class FileRangeStreambuf : public std::streambuf {
+    static constexpr size_t buffer_size = 1UL << 16;
+
+    std::filebuf file;
+    uint64_t remaining;
+    std::unique_ptr<char[]> buffer;
+
+protected:
+    int_type underflow() override;
+
+public:
+    explicit FileRangeStreambuf(FileRange const &range);
+
+    [[nodiscard]] bool is_open() const noexcept {
+        return this->file.is_open();
+    }
+};
+
+/**
+ * std::istream reading a FileRange through an owned FileRangeStreambuf.
+ */
+class FileRangeIStream : public std::istream {
+    FileRangeStreambuf buf;
+
+public:
+    explicit FileRangeIStream(FileRange const &range) : std::istream{nullptr}, buf{range} {
+        this->rdbuf(&this->buf);
+        if (not this->buf.is_open()) {
+            this->setstate(std::ios::failbit);
+        }
+    }
+};
+
+}  // namespace rdf4cpp::rdftools::io
+
+#endif  // RDFTOOLS_FILERANGE_HPP
@@ -0,0 +1,100 @@
+#include <io/LineTrackingStreambuf.hpp>
+
+#include <algorithm>
+
+namespace rdf4cpp::rdftools::io {
+
+    LineTrackingStreambuf::LineTrackingStreambuf(std::streambuf *source, size_t chunk_size, bool read_ahead)
+        : source{source},
+          chunk_size{std::max(chunk_size, size_t{1})},
+          read_ahead{read_ahead} {
+        this->prev.data.reserve(this->chunk_size);
+        this->cur.data.reserve(this->chunk_size);
+    }
+
+    LineTrackingStreambuf::int_type LineTrackingStreambuf::underflow() {
+        if (this->gptr() < this->egptr()) {
+            return traits_type::to_int_type(*this->gptr());
+        }
+
+        if (this->cur.data.size() >= this->chunk_size) {
+            auto const next_first_line = this->cur.first_line + std::count(this->cur.data.begin(), this->cur.data.end(), '\n');
+            std::swap(this->prev, this->cur);
+            this->cur.first_line = next_first_line;
+            this->cur.data.clear();
+        }
+
+        // the chunk is filled up to chunk_size, possibly over several calls. Both chunks reserved chunk_size bytes,
+        // so resizing does not move the data that was already handed out.
+        auto const old_size = this->cur.data.size();
+        auto const space = static_cast<std::streamsize>(this->chunk_size - old_size);
+        this->cur.data.resize(this->chunk_size);
+        auto const n = this->read_ahead ? this->source->sgetn(this->cur.data.data() + old_size, space)
+                                        : this->read_line(this->cur.data.data() + old_size, space);
+        this->cur.data.resize(old_size + static_cast<size_t>(std::max(n, std::streamsize{0})));
+
+        if (this->cur.data.size() == old_size) {
+            return traits_type::eof();
+        }
+
+        this->setg(this->cur.data.data(), this->cur.data.data() + old_size, this->cur.data.data() + this->cur.data.size());
+        return traits_type::to_int_type(*this->gptr());
+    }
+
+    std::streamsize LineTrackingStreambuf::read_line(char *const buf, std::streamsize const n) {
+        std::streamsize read = 0;
+        while (read < n) {
+            auto const c = this->source->sbumpc();
+            if (traits_type::eq_int_type(c, traits_type::eof())) {
+                break;
+            }
+            buf[read++] = traits_type::to_char_type(c);
+            if (buf[read - 1] == '\n') {
+                break;
+            }
+        }
+        return read;
+    }
+
+    std::optional<size_t> LineTrackingStreambuf::find_line_start(Chunk const &chunk, uint64_t const line) noexcept {
+        if (line < chunk.first_line) {
+            return std::nullopt;
+        }
+
+        size_t pos = 0;
+        for (auto cur_line = chunk.first_line; cur_line < line; ++cur_line) {
+            auto const newline = chunk.data.find('\n', pos);
+            if (newline == std::string::npos) {
+                return std::nullopt;
+            }
+            pos = newline + 1;
+        }
+        return pos;
+    }
+
+    std::optional<std::string> LineTrackingStreambuf::recent_line(uint64_t const line) const {
+        std::string result;
+
+        if (auto const start = find_line_start(this->prev, line); start.has_value() and *start < this->prev.data.size()) {
+            std::string_view const rest = std::string_view{this->prev.data}.substr(*start);
+            auto const end = rest.find('\n');
+            result = rest.substr(0, end);
+            if (end == std::string_view::npos) {
+                // line continues in the current chunk
+                std::string_view const cur_view{this->cur.data};
+                result.append(cur_view.substr(0, cur_view.find('\n')));
+            }
+        } else if (auto const cur_start = find_line_start(this->cur, line); cur_start.has_value()) {
+            std::string_view const rest = std::string_view{this->cur.data}.substr(*cur_start);
+            result = rest.substr(0, rest.find('\n'));
+        } else {
+            return std::nullopt;
+        }
+
+        if (not result.empty() and result.back() == '\r') {
+            result.pop_back();
+        }
+        return result;
+    }
+
+}  // namespace rdf4cpp::rdftools::io
@@ -0,0 +1,65 @@
+#ifndef RDFTOOLS_LINETRACKINGSTREAMBUF_HPP
+#define RDFTOOLS_LINETRACKINGSTREAMBUF_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace rdf4cpp::rdftools::io {
+
+/**
+ * Input streambuf that forwards another streambuf and remembers the most recently read input,
+ * so that recently read lines can be looked up by their (1-based) line number.
+ *
+ * The two most recent chunks of chunk_size bytes are kept. A consumer that reads ahead less than chunk_size bytes
+ * (like serd with its 4096 byte pages) can therefore always look up the line it is currently working on.
+ *
+ * By default, the source is read in chunks of chunk_size bytes, which blocks until a whole chunk is available.
+ * Without read-ahead, the source is read up to the next line break only, so that a consumer of live input (e.g. a pipe)
+ * gets each line as soon as it arrives.
+ */
+class LineTrackingStreambuf : public std::streambuf {
+    struct Chunk {
+        std::string data;
+        uint64_t first_line = 1;
+    };
+
+    std::streambuf *source;
+    size_t chunk_size;
+    bool read_ahead;
+    Chunk prev;
+    Chunk cur;
+
+    /**
+     * @return offset of the first byte of line in chunk or std::nullopt if line does not start in chunk
+     */
+    [[nodiscard]] static std::optional<size_t> find_line_start(Chunk const &chunk, uint64_t line) noexcept;
+
+    /**
+     * Reads from source up to and including the next line break, but at most n bytes.
+     * @return number of bytes read
+     */
+    std::streamsize read_line(char *buf, std::streamsize n);
+
+protected:
+    int_type underflow() override;
+
+public:
+    static constexpr size_t default_chunk_size = 1UL << 16;
+
+    explicit LineTrackingStreambuf(std::streambuf *source, size_t chunk_size = default_chunk_size, bool read_ahead = true);
+
+    /**
+     * Looks up a line that was read recently.
+     * @param line 1-based line number
+     * @return the line without its line terminator or std::nullopt if it is not available anymore (or not yet)
+     */
+    [[nodiscard]] std::optional<std::string> recent_line(uint64_t line) const;
+};
+
+}  // namespace rdf4cpp::rdftools::io
+
+#endif  // RDFTOOLS_LINETRACKINGSTREAMBUF_HPP
@@ -0,0 +1,344 @@
+#include <io/UringStreambuf.hpp>
+
+#ifdef RDFTOOLS_WITH_IO_URING
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+
+namespace rdf4cpp::rdftools::io {
+
+    namespace {
+
+        /**
+         * Only regular files can safely be accessed with several requests in flight at explicit offsets.
+         */
+        auto is_seekable(int fd) noexcept -> bool {
+            struct stat st {};
+            return ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+        }
+
+        auto current_offset(int fd) noexcept -> uint64_t {
+            auto const pos = ::lseek(fd, 0, SEEK_CUR);
+            return pos < 0 ? 0 : static_cast<uint64_t>(pos);
+        }
+
+        void init_ring(io_uring &ring, unsigned entries) {
+            if (auto const ret = io_uring_queue_init(entries, &ring, 0); ret < 0) {
+                throw std::runtime_error{fmt::format("unable to set up io_uring: {}", std::strerror(-ret))};
+            }
+        }
+
+        /**
+         * Waits for the next completion and retries if interrupted by a signal.
+         */
+        auto wait_cqe(io_uring &ring) -> io_uring_cqe * {
+            io_uring_cqe *cqe = nullptr;
+            int ret;
+            do {
+                ret = io_uring_wait_cqe(&ring, &cqe);
+            } while (ret == -EINTR);
+
+            if (ret < 0) {
+                throw std::system_error{-ret, std::system_category(), "io_uring_wait_cqe"};
+            }
+            return cqe;
+        }
+
+        auto queue_depth_for(bool seekable, unsigned queue_depth) noexcept -> unsigned {
+            // non-seekable files still get two buffers, so that the next read/write overlaps with the current buffer
+            return std::max(seekable ? queue_depth : 2U, 2U);
+        }
+
+    }  // namespace
+
+    /*
+     * UringInputStreambuf
+     */
+
+    UringInputStreambuf::UringInputStreambuf(int fd, bool owns_fd, size_t buffer_size, unsigned queue_depth)
+        : fd{fd},
+          owns_fd{owns_fd},
+          seekable{is_seekable(fd)},
+          buffer_size{buffer_size},
+          max_in_flight{seekable ? queue_depth_for(true, queue_depth) : 1U},
+          next_offset{seekable ? current_offset(fd) : 0} {
+
+        init_ring(this->ring, queue_depth_for(this->seekable, queue_depth));
+
+        this->slots.resize(queue_depth_for(this->seekable, queue_depth));
+        for (auto &slot : this->slots) {
+            slot.data = std::make_unique<char[]>(this->buffer_size);
+        }
+        this->top_up();
+    }
+
+    UringInputStreambuf::~UringInputStreambuf() {
+        // reads that are still in flight write into our buffers, so they must be finished or cancelled before freeing them
+        if (this->in_flight > 0) {
+            for (auto &slot : this->slots) {
+                if (slot.state == SlotState::InFlight) {
+                    if (auto *sqe = io_uring_get_sqe(&this->ring); sqe != nullptr) {
+                        io_uring_prep_cancel(sqe, &slot, 0);
+                        io_uring_sqe_set_data(sqe, nullptr);
+                    }
+                }
+            }
+            io_uring_submit(&this->ring);
+
+            try {
+                while (this->in_flight > 0) {
+                    this->reap_one();
+                }
+            } catch (...) {
+                // nothing sensible to do here
+            }
+        }
+
+        io_uring_queue_exit(&this->ring);
+        if (this->owns_fd) {
+            ::close(this->fd);
+        }
+    }
+
+    void UringInputStreambuf::submit(Slot &slot) {
+        auto *sqe = io_uring_get_sqe(&this->ring);
+        assert(sqe != nullptr);
+
+        // non-seekable files are read from their current position
+        io_uring_prep_read(sqe, this->fd, slot.data.get(), static_cast<unsigned>(this->buffer_size),
+                           this->seekable ? this->next_offset : static_cast<uint64_t>(-1));
+        io_uring_sqe_set_data(sqe, &slot);
+
+        slot.offset = this->next_offset;
+        slot.state = SlotState::InFlight;
+        this->next_offset += this->buffer_size;
+        ++this->in_flight;
+    }
+
+    void UringInputStreambuf::top_up() {
+        bool submitted = false;
+        while (not this->eof and this->in_flight < this->max_in_flight and
+               this->slots[this->next_submit].state == SlotState::Free) {
+            this->submit(this->slots[this->next_submit]);
+            this->next_submit = (this->next_submit + 1) % this->slots.size();
+            submitted = true;
+        }
+
+        if (submitted) {
+            if (auto const ret = io_uring_submit(&this->ring); ret < 0) {
+                throw std::system_error{-ret, std::system_category(), "io_uring_submit"};
+            }
+        }
+    }
+
+    void UringInputStreambuf::reap_one() {
+        auto *cqe = wait_cqe(this->ring);
+        auto *slot = static_cast<Slot *>(io_uring_cqe_get_data(cqe));
+        auto const res = cqe->res;
+        io_uring_cqe_seen(&this->ring, cqe);
+
+        if (slot == nullptr) {
+            // completion of a cancellation request
+            return;
+        }
+        slot->result = res;
+        slot->state = SlotState::Completed;
+        --this->in_flight;
+    }
+
+    UringInputStreambuf::int_type UringInputStreambuf::underflow() {
+        if (this->gptr() < this->egptr()) {
+            return traits_type::to_int_type(*this->gptr());
+        }
+
+        // hand back the buffer that was consumed last
+        if (auto &prev = this->slots[this->cur_slot]; prev.state == SlotState::Current) {
+            prev.state = SlotState::Free;
+            this->cur_slot = (this->cur_slot + 1) % this->slots.size();
+        }
+
+        if (this->eof) {
+            return traits_type::eof();
+        }
+
+        this->top_up();
+
+        auto &slot = this->slots[this->cur_slot];
+        while (slot.state == SlotState::InFlight) {
+            this->reap_one();
+        }
+
+        if (slot.result < 0) {
+            this->eof = true;
+            throw std::system_error{-slot.result, std::system_category(), "io_uring read"};
+        }
+
+        auto filled = static_cast<size_t>(slot.result);
+        if (this->seekable and filled > 0 and filled < this->buffer_size) {
+            // the reads that are already in flight expect this buffer to end at slot.offset + buffer_size.
+            // short reads are rare for regular files, so the rest is filled synchronously.
+            while (filled < this->buffer_size) {
+                auto const n = ::pread(this->fd, slot.data.get() + filled, this->buffer_size - filled,
+                                       static_cast<off_t>(slot.offset + filled));
+                if (n < 0 and errno == EINTR) {
+                    continue;
+                } else if (n < 0) {
+                    this->eof = true;
+                    throw std::system_error{errno, std::system_category(), "pread"};
+                } else if (n == 0) {
+                    break;
+                }
+                filled += static_cast<size_t>(n);
+            }
+        }
+
+        if (filled == 0) {
+            slot.state = SlotState::Free;
+            this->eof = true;
+            return traits_type::eof();
+        }
+
+        slot.state = SlotState::Current;
+        this->setg(slot.data.get(), slot.data.get(), slot.data.get() + filled);
+
+        // start reading the next buffer while this one is consumed
+        this->top_up();
+
+        return traits_type::to_int_type(*this->gptr());
+    }
+
+    /*
+     * UringOutputStreambuf
+     */
+
+    UringOutputStreambuf::UringOutputStreambuf(int fd, bool owns_fd, size_t buffer_size, unsigned queue_depth)
+        : fd{fd},
+          owns_fd{owns_fd},
+          seekable{is_seekable(fd)},
+          buffer_size{buffer_size},
+          max_in_flight{seekable ? queue_depth_for(true, queue_depth) : 1U},
+          next_offset{seekable ? current_offset(fd) : 0} {
+
+        init_ring(this->ring, queue_depth_for(this->seekable, queue_depth));
+
+        this->slots.resize(queue_depth_for(this->seekable, queue_depth));
+        for (auto &slot : this->slots) {
+            slot.data = std::make_unique<char[]>(this->buffer_size);
+        }
+        this->setp(this->slots[0].data.get(), this->slots[0].data.get() + this->buffer_size);
+    }
+
+    UringOutputStreambuf::~UringOutputStreambuf() {
+        try {
+            this->sync();
+        } catch (...) {
+            // nothing sensible to do here
+        }
+
+        io_uring_queue_exit(&this->ring);
+        if (this->owns_fd) {
+            ::close(this->fd);
+        }
+    }
+
+    void UringOutputStreambuf::write_remainder(Slot const &slot, size_t written) {
+        while (written < slot.size) {
+            auto const n = this->seekable
+                                   ? ::pwrite(this->fd, slot.data.get() + written, slot.size - written,
+                                              static_cast<off_t>(slot.offset + written))
+                                   : ::write(this->fd, slot.data.get() + written, slot.size - written);
+            if (n < 0 and errno == EINTR) {
+                continue;
+            } else if (n <= 0) {
+                this->failed = true;
+                return;
+            }
+            written += static_cast<size_t>(n);
+        }
+    }
+
+    void UringOutputStreambuf::reap_one() {
+        auto *cqe = wait_cqe(this->ring);
+        auto *slot = static_cast<Slot *>(io_uring_cqe_get_data(cqe));
+        auto const res = cqe->res;
+        io_uring_cqe_seen(&this->ring, cqe);
+
+        slot->in_flight = false;
+        --this->in_flight;
+
+        if (res < 0) {
+            this->failed = true;
+        } else if (static_cast<size_t>(res) < slot->size) {
+            // at most one write is in flight for non-seekable files, so finishing it synchronously keeps the order
+            this->write_remainder(*slot, static_cast<size_t>(res));
+        }
+    }
+
+    bool UringOutputStreambuf::submit_current() {
+        auto &slot = this->slots[this->cur_slot];
+        slot.size = static_cast<size_t>(this->pptr() - this->pbase());
+        if (slot.size == 0) {
+            return not this->failed;
+        }
+
+        while (this->in_flight >= this->max_in_flight) {
+            this->reap_one();
+        }
+
+        auto *sqe = io_uring_get_sqe(&this->ring);
+        assert(sqe != nullptr);
+        io_uring_prep_write(sqe, this->fd, slot.data.get(), static_cast<unsigned>(slot.size),
+                            this->seekable ? this->next_offset : static_cast<uint64_t>(-1));
+        io_uring_sqe_set_data(sqe, &slot);
+        if (auto const ret = io_uring_submit(&this->ring); ret < 0) {
+            throw std::system_error{-ret, std::system_category(), "io_uring_submit"};
+        }
+
+        slot.offset = this->next_offset;
+        slot.in_flight = true;
+        this->next_offset += slot.size;
+        ++this->in_flight;
+
+        // continue filling the next buffer as soon as it is not written anymore
+        this->cur_slot = (this->cur_slot + 1) % this->slots.size();
+        auto &next = this->slots[this->cur_slot];
+        while (next.in_flight) {
+            this->reap_one();
+        }
+        this->setp(next.data.get(), next.data.get() + this->buffer_size);
+
+        return not this->failed;
+    }
+
+    UringOutputStreambuf::int_type UringOutputStreambuf::overflow(int_type ch) {
+        if (not this->submit_current()) {
+            return traits_type::eof();
+        }
+
+        if (not traits_type::eq_int_type(ch, traits_type::eof())) {
+            *this->pptr() = traits_type::to_char_type(ch);
+            this->pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    int UringOutputStreambuf::sync() {
+        this->submit_current();
+        while (this->in_flight > 0) {
+            this->reap_one();
+        }
+        return this->failed ? -1 : 0;
+    }
+
+}  // namespace rdf4cpp::rdftools::io
+
+#endif  // RDFTOOLS_WITH_IO_URING
@@ -0,0 +1,159 @@
+#ifndef RDFTOOLS_URINGSTREAMBUF_HPP
+#define RDFTOOLS_URINGSTREAMBUF_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+#ifdef RDFTOOLS_WITH_IO_URING
+#include <liburing.h>
+#endif
+
+namespace rdf4cpp::rdftools::io {
+
+/**
+ * true if the binary was built with io_uring support (cmake -DWITH_IO_URING=ON)
+ */
+#ifdef RDFTOOLS_WITH_IO_URING
+inline constexpr bool uring_available = true;
+#else
+inline constexpr bool uring_available = false;
+#endif
+
+inline constexpr size_t default_uring_buffer_size = 1UL << 20;
+inline constexpr unsigned default_uring_queue_depth = 4;
+
+#ifdef RDFTOOLS_WITH_IO_URING
+
+/**
+ * Input streambuf that keeps several reads in flight via io_uring ahead of the consumer.
+ * Regular files are read ahead at explicit offsets with queue_depth buffers.
+ * Pipes and other non-seekable files use a single buffer in flight, so that reads complete in order.
+ */
+class UringInputStreambuf : public std::streambuf {
+    enum struct SlotState {
+        Free,
+        InFlight,
+        Completed,
+        Current,
+    };
+
+    struct Slot {
+        std::unique_ptr<char[]> data;
+        uint64_t offset = 0;
+        int result = 0;
+        SlotState state = SlotState::Free;
+    };
+
+    io_uring ring{};
+    int fd;
+    bool owns_fd;
+    bool seekable;
+    size_t buffer_size;
+    unsigned max_in_flight;
+    unsigned in_flight = 0;
+    std::vector<Slot> slots;
+    size_t cur_slot = 0;
+    size_t next_submit = 0;
+    uint64_t next_offset;
+    bool eof = false;
+
+    void submit(Slot &slot);
+    void top_up();
+    void reap_one();
+
+protected:
+    int_type underflow() override;
+
+public:
+    /**
+     * @param fd file descriptor to read from
+     * @param owns_fd if true, fd is closed on destruction
+     * @throws std::runtime_error if the io_uring cannot be set up
+     */
+    UringInputStreambuf(int fd, bool owns_fd, size_t buffer_size = default_uring_buffer_size,
+                        unsigned queue_depth = default_uring_queue_depth);
+    ~UringInputStreambuf() override;
+};
+
+/**
+ * Output streambuf that hands full buffers to io_uring and continues filling the next one while the write is in flight.
+ * Regular files are written at explicit offsets with up to queue_depth writes in flight.
+ * Pipes and other non-seekable files use a single write in flight, so that the output stays in order.
+ */
+class UringOutputStreambuf : public std::streambuf {
+    struct Slot {
+        std::unique_ptr<char[]> data;
+        size_t size = 0;
+        uint64_t offset = 0;
+        bool in_flight = false;
+    };
+
+    io_uring ring{};
+    int fd;
+    bool owns_fd;
+    bool seekable;
+    size_t buffer_size;
+    unsigned max_in_flight;
+    unsigned in_flight = 0;
+    std::vector<Slot> slots;
+    size_t cur_slot = 0;
+    uint64_t next_offset;
+    bool failed = false;
+
+    bool submit_current();
+    void reap_one();
+    void write_remainder(Slot const &slot, size_t written);
+
+protected:
+    int_type overflow(int_type ch) override;
+    int sync() override;
+
+public:
+    /**
+     * @param fd file descriptor to write to
+     * @param owns_fd if true, fd is closed on destruction
+     * @throws std::runtime_error if the io_uring cannot be set up
+     */
+    UringOutputStreambuf(int fd, bool owns_fd, size_t buffer_size = default_uring_buffer_size,
+                         unsigned queue_depth = default_uring_queue_depth);
+    ~UringOutputStreambuf() override;
+};
+
+/**
+ * std::istream reading through an owned UringInputStreambuf.
+ */
+class UringIStream : public std::istream {
+    UringInputStreambuf buf;
+
+public:
+    UringIStream(int fd, bool owns_fd) : std::istream{nullptr}, buf{fd, owns_fd} {
+        this->rdbuf(&this->buf);
+    }
+};
+
+/**
+ * std::ostream writing through an owned UringOutputStreambuf.
+ */
+class UringOStream : public std::ostream {
+    UringOutputStreambuf buf;
+
+public:
+    UringOStream(int fd, bool owns_fd) : std::ostream{nullptr}, buf{fd, owns_fd} {
+        this->rdbuf(&this->buf);
+    }
+
+    ~UringOStream() override {
+        this->flush();
+    }
+};
+
+#endif  // RDFTOOLS_WITH_IO_URING
+
+}  // namespace rdf4cpp::rdftools::io
+
+#endif  // RDFTOOLS_URINGSTREAMBUF_HPP
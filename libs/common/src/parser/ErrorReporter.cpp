@@ -0,0 +1,175 @@
+#include <parser/ErrorReporter.hpp>
+
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+namespace rdf4cpp::rdftools::parser {
+
+    namespace {
+
+        auto error_type_name(ParsingError::Type const type) noexcept -> std::string_view {
+            switch (type) {
+                case ParsingError::Type::EofReached:
+                    return "EofReached";
+                case ParsingError::Type::BadSyntax:
+                    return "BadSyntax";
+                case ParsingError::Type::BadIri:
+                    return "BadIri";
+                case ParsingError::Type::BadLiteral:
+                    return "BadLiteral";
+                case ParsingError::Type::BadBlankNode:
+                    return "BadBlankNode";
+                case ParsingError::Type::BadCurie:
+                    return "BadCurie";
+                case ParsingError::Type::Internal:
+                    return "Internal";
+                default:
+                    return "Unknown";
+            }
+        }
+
+    }  // namespace
+
+    ErrorReporter::ErrorReporter(Options options, io::LineTrackingStreambuf const *recent_lines)
+        : options{std::move(options)},
+          recent_lines{recent_lines},
+          last_summary{std::chrono::steady_clock::now()} {
+
+        if (this->options.quarantine_path.has_value()) {
+            this->quarantine.open(*this->options.quarantine_path, std::ios::binary | std::ios::trunc);
+            if (not this->quarantine.is_open()) {
+                throw std::runtime_error{fmt::format("unable to open quarantine file {}", this->options.quarantine_path->string())};
+            }
+            this->quarantine_buffer.reserve(quarantine_flush_threshold);
+        }
+    }
+
+    ErrorReporter::~ErrorReporter() noexcept {
+        try {
+            this->flush_quarantine();
+        } catch (...) {
+            // nothing sensible to do here
+        }
+    }
+
+    size_t ErrorReporter::index_of(ParsingError::Type const type) noexcept {
+        auto const index = static_cast<size_t>(type);
+        return index < max_error_types ? index : max_error_types - 1;
+    }
+
+    uint64_t ErrorReporter::count_of(ParsingError::Type const type) const noexcept {
+        return this->counts[index_of(type)];
+    }
+
+    bool ErrorReporter::wants_message_unlocked(ParsingError::Type const type) const noexcept {
+        return this->count_of(type) < this->options.max_reports_per_type;
+    }
+
+    bool ErrorReporter::wants_message(ParsingError::Type const type) const noexcept {
+        std::lock_guard const lock{this->mutex};
+        return this->wants_message_unlocked(type);
+    }
+
+    IStreamQuadIterator::error_message_filter_type ErrorReporter::error_message_filter() const {
+        return [this](ParsingError::Type const type) { return this->wants_message(type); };
+    }
+
+    void ErrorReporter::report(ParsingError const &error, std::string_view const origin) {
+        std::lock_guard const lock{this->mutex};
+
+        if (this->wants_message_unlocked(error.error_type)) {
+            if (origin.empty()) {
+                spdlog::warn("{}:{}: {} ({})", error.line, error.col, error.message, error_type_name(error.error_type));
+            } else {
+                spdlog::warn("{}:{}:{}: {} ({})", origin, error.line, error.col, error.message, error_type_name(error.error_type));
+            }
+            if (this->count_of(error.error_type) + 1 == this->options.max_reports_per_type) {
+                spdlog::warn("Reached {} reported errors of type {}. Further errors of this type are only counted.",
+                             this->options.max_reports_per_type, error_type_name(error.error_type));
+            }
+        }
+
+        ++this->counts[index_of(error.error_type)];
+        ++this->total;
+
+        if (this->quarantine.is_open()) {
+            this->quarantine_line(error.line);
+        }
+
+        this->log_summary_if_due();
+    }
+
+    void ErrorReporter::log_summary_if_due() {
+        auto const now = std::chrono::steady_clock::now();
+        if (now - this->last_summary < this->options.summary_interval) {
+            return;
+        }
+        this->last_summary = now;
+
+        auto const parsed = this->parsed.load(std::memory_order_relaxed);
+        if (this->total == 0) {
+            spdlog::info("Parsed {} triples without errors so far.", parsed);
+            return;
+        }
+        this->log_summary(fmt::format("Parsed {} triples, {} new errors.", parsed, this->total - this->total_at_last_summary));
+        this->total_at_last_summary = this->total;
+    }
+
+    void ErrorReporter::log_summary(std::string_view const prefix) const {
+        std::string per_type;
+        for (auto const type : {ParsingError::Type::BadSyntax, ParsingError::Type::BadIri, ParsingError::Type::BadLiteral,
+                                ParsingError::Type::BadBlankNode, ParsingError::Type::BadCurie, ParsingError::Type::EofReached,
+                                ParsingError::Type::Internal}) {
+            if (auto const count = this->count_of(type); count > 0) {
+                fmt::format_to(std::back_inserter(per_type), "{}{}: {}", per_type.empty() ? "" : ", ", error_type_name(type), count);
+            }
+        }
+        spdlog::warn("{} {} errors in total ({}).", prefix, this->total, per_type);
+    }
+
+    void ErrorReporter::quarantine_line(uint64_t const line) {
+        // several errors may point to the same line
+        if (line == this->last_quarantined_line) {
+            return;
+        }
+        this->last_quarantined_line = line;
+
+        if (auto const text = this->recent_lines != nullptr ? this->recent_lines->recent_line(line) : std::nullopt; text.has_value()) {
+            this->quarantine_buffer.append(*text);
+        } else {
+            fmt::format_to(std::back_inserter(this->quarantine_buffer), "# line {} is not available anymore", line);
+        }
+        this->quarantine_buffer.push_back('\n');
+        ++this->quarantined;
+
+        if (this->quarantine_buffer.size() >= quarantine_flush_threshold) {
+            this->flush_quarantine();
+        }
+    }
+
+    void ErrorReporter::flush_quarantine() {
+        if (this->quarantine.is_open() and not this->quarantine_buffer.empty()) {
+            this->quarantine.write(this->quarantine_buffer.data(), static_cast<std::streamsize>(this->quarantine_buffer.size()));
+            this->quarantine_buffer.clear();
+        }
+    }
+
+    void ErrorReporter::finish() {
+        std::lock_guard const lock{this->mutex};
+
+        if (this->total > 0) {
+            this->log_summary("Finished parsing.");
+        }
+
+        if (this->quarantine.is_open()) {
+            this->flush_quarantine();
+            this->quarantine.close();
+            spdlog::info("Wrote {} rejected lines to {}.", this->quarantined, this->options.quarantine_path->string());
+        }
+    }
+
+}  // namespace rdf4cpp::rdftools::parser
@@ -0,0 +1,127 @@
+#ifndef RDFTOOLS_ERRORREPORTER_HPP
+#define RDFTOOLS_ERRORREPORTER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <parser/IStreamQuadIterator.hpp>
+#include <io/LineTrackingStreambuf.hpp>
+
+namespace rdf4cpp::rdftools::parser {
+
+/**
+ * Aggregated, rate-limited reporting of ParsingErrors.
+ *
+ * Errors are counted per ParsingError::Type. Only the first max_reports_per_type errors of each type are logged individually,
+ * the rest is covered by summaries that are logged every summary_interval together with the number of parsed triples.
+ * Call count_parsed() for the parsed triples, so that the summaries continue while no errors arrive. Optionally, the input lines that caused errors are collected and written to a
+ * quarantine file in bulk.
+ *
+ * Pass error_message_filter() to IStreamQuadIterator, so that error messages are only formatted if they are going to be logged.
+ * The member functions are thread-safe, so that the parsers of several parts of a file can share a reporter.
+ */
+class ErrorReporter {
+public:
+    struct Options {
+        uint64_t max_reports_per_type = std::numeric_limits<uint64_t>::max();
+        std::chrono::seconds summary_interval{10};
+        std::optional<std::filesystem::path> quarantine_path = std::nullopt;
+    };
+
+private:
+    static constexpr size_t max_error_types = 16;
+    static constexpr size_t quarantine_flush_threshold = 1UL << 20;
+    /**
+     * count_parsed() only looks at the clock when the number of parsed triples crosses a multiple of this
+     */
+    static constexpr uint64_t summary_check_interval = 1UL << 12;
+
+    Options options;
+    io::LineTrackingStreambuf const *recent_lines;
+
+    mutable std::mutex mutex;
+
+    std::array<uint64_t, max_error_types> counts{};
+    uint64_t total = 0;
+    uint64_t total_at_last_summary = 0;
+    std::chrono::steady_clock::time_point last_summary;
+    std::atomic<uint64_t> parsed = 0;
+
+    std::ofstream quarantine;
+    std::string quarantine_buffer;
+    uint64_t last_quarantined_line = 0;
+    uint64_t quarantined = 0;
+
+    [[nodiscard]] static size_t index_of(ParsingError::Type type) noexcept;
+    [[nodiscard]] uint64_t count_of(ParsingError::Type type) const noexcept;
+    [[nodiscard]] bool wants_message_unlocked(ParsingError::Type type) const noexcept;
+
+    void log_summary(std::string_view prefix) const;
+    void log_summary_if_due();
+    void quarantine_line(uint64_t line);
+    void flush_quarantine();
+
+public:
+    /**
+     * @param options reporting options
+     * @param recent_lines source of the input lines for the quarantine file. Must be set if options.quarantine_path is set.
+     * @throws std::runtime_error if the quarantine file cannot be opened
+     */
+    explicit ErrorReporter(Options options, io::LineTrackingStreambuf const *recent_lines = nullptr);
+
+    ErrorReporter(ErrorReporter const &) = delete;
+    ErrorReporter &operator=(ErrorReporter const &) = delete;
+    ~ErrorReporter() noexcept;
+
+    /**
+     * @return true if the next error of type will be logged individually, i.e. its message is needed
+     */
+    [[nodiscard]] bool wants_message(ParsingError::Type type) const noexcept;
+
+    /**
+     * @return a filter for IStreamQuadIterator that only lets messages through which are going to be logged
+     */
+    [[nodiscard]] IStreamQuadIterator::error_message_filter_type error_message_filter() const;
+
+    /**
+     * Counts error and logs it, if it is within the first max_reports_per_type errors of its type.
+     * @param origin (optional) where the parser that found the error started, e.g. a file. Logged in front of the error's line and column,
+     *      which are relative to that start.
+     */
+    void report(ParsingError const &error, std::string_view origin = {});
+
+    /**
+     * Counts n parsed triples and logs a summary if summary_interval has passed since the last one.
+     * Cheap enough to be called for every triple.
+     */
+    void count_parsed(uint64_t const n = 1) {
+        auto const before = this->parsed.fetch_add(n, std::memory_order_relaxed);
+        if ((before + n) / summary_check_interval != before / summary_check_interval) [[unlikely]] {
+            std::lock_guard const lock{this->mutex};
+            this->log_summary_if_due();
+        }
+    }
+
+    /**
+     * Logs the final summary and flushes the quarantine file.
+     */
+    void finish();
+
+    [[nodiscard]] uint64_t num_errors() const noexcept {
+        std::lock_guard const lock{this->mutex};
+        return this->total;
+    }
+};
+
+}  // namespace rdf4cpp::rdftools::parser
+
+#endif  // RDFTOOLS_ERRORREPORTER_HPP
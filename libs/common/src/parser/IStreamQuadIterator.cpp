@@ -15,8 +15,11 @@ IStreamQuadIterator::IStreamQuadIterator(std::default_sentinel_t) noexcept
     : impl{nullptr} {
 }
 
-IStreamQuadIterator::IStreamQuadIterator(std::istream &istream, ParsingFlags flags, prefix_storage_type prefixes) noexcept
-    : impl{std::make_unique<Impl>(istream, flags, std::move(prefixes))} {
+IStreamQuadIterator::IStreamQuadIterator(std::istream &istream, ParsingFlags flags, prefix_storage_type prefixes,
+                                         error_message_filter_type error_message_filter, std::string anonymous_blank_node_suffix,
+                                         bool read_ahead) noexcept
+    : impl{std::make_unique<Impl>(istream, flags, std::move(prefixes), std::move(error_message_filter), std::move(anonymous_blank_node_suffix),
+                                  read_ahead)} {
     ++*this;
 }
 
@@ -24,6 +27,11 @@ IStreamQuadIterator::IStreamQuadIterator(IStreamQuadIterator &&other) noexcept =
 
 IStreamQuadIterator::~IStreamQuadIterator() noexcept = default;
 
+typename IStreamQuadIterator::prefix_storage_type const &IStreamQuadIterator::prefixes() const noexcept {
+    static prefix_storage_type const no_prefixes;
+    return this->impl != nullptr ? this->impl->prefix_map() : no_prefixes;
+}
+
 typename IStreamQuadIterator::reference IStreamQuadIterator::operator*() const noexcept {
     return this->cur;
 }
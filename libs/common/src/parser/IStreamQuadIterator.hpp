@@ -1,8 +1,10 @@
 #ifndef RDFTOOLS_ISTREAMQUADITERATOR_HPP
 #define RDFTOOLS_ISTREAMQUADITERATOR_HPP
 
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <string>
 
 #include <nonstd/expected.hpp>
 
@@ -57,6 +59,12 @@ struct IStreamQuadIterator {
             rdf4cpp::rdf::storage::util::robin_hood::hash<std::string_view>,
             std::equal_to<>>;
 
+    /**
+     * Decides whether the message of a ParsingError of the given type is formatted.
+     * Errors whose message is not formatted carry an empty message. This avoids formatting costs for errors that are only counted.
+     */
+    using error_message_filter_type = std::function<bool(ParsingError::Type)>;
+
 private:
     struct Impl;
 
@@ -81,10 +89,26 @@ public:
 
     IStreamQuadIterator &operator=(IStreamQuadIterator &&) noexcept = default;
 
+    /**
+     * @param prefixes prefixes that are known before the first line of istream, e.g. when parsing a part of a file (see split_at_statements())
+     * @param anonymous_blank_node_suffix appended to the labels that the parser generates for anonymous blank nodes ([] and collections).
+     *      Generated labels restart for each parser, so parts of the same file must be parsed with distinct suffixes. Labels from the input are not changed.
+     * @param read_ahead if true, istream is read in pages of 4096 bytes. Otherwise, it is read byte by byte, so that a statement is
+     *      parsed as soon as its last byte is available instead of when the rest of its page arrives. Use false for live input, e.g. a pipe.
+     */
     explicit IStreamQuadIterator(std::istream &istream, ParsingFlags flags = ParsingFlags::none(),
-                                 prefix_storage_type prefixes = {}) noexcept;
+                                 prefix_storage_type prefixes = {},
+                                 error_message_filter_type error_message_filter = {},
+                                 std::string anonymous_blank_node_suffix = {},
+                                 bool read_ahead = true) noexcept;
     ~IStreamQuadIterator() noexcept;
 
+    /**
+     * @return the prefixes known to the parser, i.e. the ones passed to the constructor and those declared in the input so far.
+     * Empty for the end-of-stream iterator.
+     */
+    [[nodiscard]] prefix_storage_type const &prefixes() const noexcept;
+
     reference operator*() const noexcept;
     pointer operator->() const noexcept;
     IStreamQuadIterator &operator++();
@@ -63,6 +63,17 @@ namespace rdf4cpp::rdftools::parser {
             return *self ? 0 : 1;
         }
 
+        /**
+         * serd labels anonymous blank nodes b1, b2, ... and renames labels from the input that have this form to B1, B2, ...
+         * So a label is generated iff it is 'b' followed by a digit.
+         */
+        static bool is_generated_blank_node_label(std::string_view label) noexcept {
+            if (label.starts_with("_:")) {
+                label.remove_prefix(2);
+            }
+            return label.size() >= 2 && label[0] == 'b' && label[1] >= '0' && label[1] <= '9';
+        }
+
     }  // namespace util
 
     std::string_view IStreamQuadIterator::Impl::node_into_string_view(SerdNode const *node) noexcept {
@@ -86,7 +97,11 @@ namespace rdf4cpp::rdftools::parser {
 
     nonstd::expected<CowString, SerdStatus> IStreamQuadIterator::Impl::get_bnode(SerdNode const *node) noexcept {
         try {
-            return CowString{Borrowed{}, node_into_string_view(node)};
+            auto const label = node_into_string_view(node);
+            if (!this->anonymous_blank_node_suffix.empty() && util::is_generated_blank_node_label(label)) {
+                return CowString{Owned{}, fmt::format("{}{}", label, this->anonymous_blank_node_suffix)};
+            }
+            return CowString{Borrowed{}, label};
         } catch (std::runtime_error const &e) {
             // TODO: check when actual blank node validation implemented
             // NOTE: line, col not entirely accurate as this function is called after a triple was parsed
@@ -229,19 +244,22 @@ namespace rdf4cpp::rdftools::parser {
 
     SerdStatus IStreamQuadIterator::Impl::on_error(void *voided_self, SerdError const *error) noexcept {
         auto *self = reinterpret_cast<Impl *>(voided_self);
+        auto const error_type = parsing_error_type_from_serd(error->status);
 
-        auto const buf_sz = vsnprintf(nullptr, 0, error->fmt, *error->args);
         std::string message;
+        if (self->wants_error_message(error_type)) {
+            auto const buf_sz = vsnprintf(nullptr, 0, error->fmt, *error->args);
 
-        message.resize(buf_sz + 1);  // +1 for null-terminator
-        vsnprintf(message.data(), message.size(), error->fmt, *error->args);
-        message.resize(buf_sz - 1);  // drop null-terminator from vsnprintf and newline from serd
+            message.resize(buf_sz + 1);  // +1 for null-terminator
+            vsnprintf(message.data(), message.size(), error->fmt, *error->args);
+            message.resize(buf_sz - 1);  // drop null-terminator from vsnprintf and newline from serd
+        }
 
         self->last_error = ParsingError{
-                .error_type = parsing_error_type_from_serd(error->status),
+                .error_type = error_type,
                 .line = error->line,
                 .col = error->col,
-                .message = message};
+                .message = std::move(message)};
 
         return SerdStatus::SERD_SUCCESS;
     }
@@ -366,17 +384,22 @@ namespace rdf4cpp::rdftools::parser {
         return SERD_SUCCESS;
     }
 
-    IStreamQuadIterator::Impl::Impl(std::istream &istream, ParsingFlags flags, PrefixMap prefixes) noexcept
+    IStreamQuadIterator::Impl::Impl(std::istream &istream, ParsingFlags flags, PrefixMap prefixes,
+                                    ErrorMessageFilter error_message_filter, std::string anonymous_blank_node_suffix,
+                                    bool read_ahead) noexcept
             : istream{std::ref(istream)},
               reader{serd_reader_new(SerdSyntax::SERD_TURTLE, this, nullptr, &Impl::on_base, &Impl::on_prefix,
                                      &Impl::on_stmt, nullptr)},
               prefixes{std::move(prefixes)},
+              error_message_filter{std::move(error_message_filter)},
+              anonymous_blank_node_suffix{std::move(anonymous_blank_node_suffix)},
               no_parse_prefixes{flags.contains(ParsingFlag::NoParsePrefix)} {
 
         serd_reader_set_strict(this->reader.get(), flags.contains(ParsingFlag::Strict));
         serd_reader_set_error_sink(this->reader.get(), &Impl::on_error, this);
+        // serd takes a short page for the end of the input, so pages cannot be cut short when input is pending
         serd_reader_start_source_stream(this->reader.get(), &util::istream_read, &util::istream_is_ok,
-                                        &this->istream.get(), nullptr, 4096);
+                                        &this->istream.get(), nullptr, read_ahead ? 4096 : 1);
     }
 
     std::optional<nonstd::expected<StringQuad, ParsingError>> IStreamQuadIterator::Impl::next() noexcept {
@@ -399,10 +422,10 @@ namespace rdf4cpp::rdftools::parser {
                     }
 
                     serd_reader_skip_error(this->reader.get());
-                    return nonstd::make_unexpected(*this->last_error);
+                    return nonstd::make_unexpected(std::move(*this->last_error));
                 } else if (this->last_error.has_value()) {
                     // non-fatal, artificially inserted error
-                    return nonstd::make_unexpected(*this->last_error);
+                    return nonstd::make_unexpected(std::move(*this->last_error));
                 }
             }
         }
@@ -22,6 +22,7 @@ struct IStreamQuadIterator::Impl {
 private:
 
     using PrefixMap = IStreamQuadIterator::prefix_storage_type;
+    using ErrorMessageFilter = IStreamQuadIterator::error_message_filter_type;
 
     struct SerdReaderDelete {
         inline void operator()(SerdReader *rdr) const noexcept {
@@ -38,6 +39,8 @@ private:
 
 
     PrefixMap prefixes;
+    ErrorMessageFilter error_message_filter;
+    std::string anonymous_blank_node_suffix;
     std::deque<std::array<CowString, 4UL>> quad_buffer;
     std::optional<ParsingError> last_error;
     bool end_flag = false;
@@ -47,6 +50,10 @@ private:
     static std::string_view node_into_string_view(SerdNode const *node) noexcept;
     static ParsingError::Type parsing_error_type_from_serd(SerdStatus st) noexcept;
 
+    [[nodiscard]] inline bool wants_error_message(ParsingError::Type const type) const noexcept {
+        return !this->error_message_filter || this->error_message_filter(type);
+    }
+
 private:
     nonstd::expected<CowString, SerdStatus> get_bnode(SerdNode const *node) noexcept;
     nonstd::expected<CowString, SerdStatus> get_iri(SerdNode const *node) noexcept;
@@ -59,7 +66,8 @@ private:
     static SerdStatus on_stmt(void *voided_self, SerdStatementFlags, SerdNode const *graph, SerdNode const *subj, SerdNode const *pred, SerdNode const *obj, SerdNode const *obj_datatype, SerdNode const *obj_lang) noexcept;
 
 public:
-    Impl(std::istream &istream, ParsingFlags flags, PrefixMap prefixes) noexcept;
+    Impl(std::istream &istream, ParsingFlags flags, PrefixMap prefixes, ErrorMessageFilter error_message_filter = {},
+         std::string anonymous_blank_node_suffix = {}, bool read_ahead = true) noexcept;
 
     /**
      * @return true if this will no longer yield values
@@ -69,6 +77,13 @@ public:
         return this->end_flag && quad_buffer.empty();
     }
 
+    /**
+     * @return the prefixes known to the parser, i.e. the initial ones and those declared in the input so far
+     */
+    [[nodiscard]] inline PrefixMap const &prefix_map() const noexcept {
+        return this->prefixes;
+    }
+
     inline bool operator==(Impl const &other) const noexcept {
         return this->reader == other.reader;
     }
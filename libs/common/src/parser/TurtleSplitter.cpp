@@ -0,0 +1,303 @@
+#include <parser/TurtleSplitter.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <dictionary/MappedFile.hpp>
+
+namespace rdf4cpp::rdftools::parser {
+
+    namespace {
+
+        using PrefixMap = IStreamQuadIterator::prefix_storage_type;
+
+        bool is_space(char const c) noexcept {
+            return c == ' ' or c == '\t' or c == '\n' or c == '\r';
+        }
+
+        /**
+         * Characters that continue a prefixed name, blank node label or number after a '.'. A '.' followed by one of them
+         * does not terminate a statement.
+         */
+        bool continues_name(char const c) noexcept {
+            auto const u = static_cast<unsigned char>(c);
+            return std::isalnum(u) or c == '_' or c == '-' or c == ':' or c == '%' or c == '\\' or u >= 0x80;
+        }
+
+        /**
+         * Characters that need attention while scanning a statement. Everything else is skipped in a tight loop.
+         */
+        constexpr std::array<bool, 256> statement_specials = [] {
+            std::array<bool, 256> specials{};
+            for (unsigned char const c : std::string_view{"<\"'#\\[]()."}) {
+                specials[c] = true;
+            }
+            return specials;
+        }();
+
+        bool iequals(std::string_view const a, std::string_view const b) noexcept {
+            return std::ranges::equal(a, b, [](char const x, char const y) {
+                return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+            });
+        }
+
+        /**
+         * Moves through Turtle text statement by statement and records prefix and base directives on the way.
+         */
+        class StatementScanner {
+            std::string_view data;
+            size_t pos = 0;
+            PrefixMap prefixes;
+
+            void skip_comment() noexcept {
+                auto const end = this->data.find('\n', this->pos);
+                this->pos = end == std::string_view::npos ? this->data.size() : end + 1;
+            }
+
+            void skip_space_and_comments() noexcept {
+                while (this->pos < this->data.size()) {
+                    if (is_space(this->data[this->pos])) {
+                        ++this->pos;
+                    } else if (this->data[this->pos] == '#') {
+                        this->skip_comment();
+                    } else {
+                        break;
+                    }
+                }
+            }
+
+            /**
+             * Skips the string literal starting at pos with the given quote.
+             */
+            void skip_string(char const quote) noexcept {
+                std::array<char, 3> const stops{quote, '\\', '\n'};
+
+                if (this->pos + 2 < this->data.size() and this->data[this->pos + 1] == quote and this->data[this->pos + 2] == quote) {
+                    // long string: may contain line breaks and up to two consecutive quotes
+                    this->pos += 3;
+                    while (this->pos < this->data.size()) {
+                        auto const stop = this->data.find_first_of(std::string_view{stops.data(), 2}, this->pos);
+                        if (stop == std::string_view::npos) {
+                            this->pos = this->data.size();
+                        } else if (this->data[stop] == '\\') {
+                            this->pos = stop + 2;
+                        } else {
+                            auto const run_end = std::min(this->data.find_first_not_of(quote, stop), this->data.size());
+                            this->pos = run_end;
+                            if (run_end - stop >= 3) {
+                                return;
+                            }
+                        }
+                    }
+                    return;
+                }
+
+                ++this->pos;
+                while (this->pos < this->data.size()) {
+                    auto const stop = this->data.find_first_of(std::string_view{stops.data(), stops.size()}, this->pos);
+                    if (stop == std::string_view::npos) {
+                        this->pos = this->data.size();
+                    } else if (this->data[stop] == '\\') {
+                        this->pos = stop + 2;
+                    } else {
+                        // a line break ends an (invalid) short string as well, so that the scan recovers on the next line
+                        this->pos = this->data[stop] == quote ? stop + 1 : stop;
+                        return;
+                    }
+                }
+            }
+
+            /**
+             * Scans to the '.' that terminates the statement starting at pos.
+             * @return position right after the statement
+             */
+            size_t scan_statement() noexcept {
+                size_t depth = 0;
+                while (this->pos < this->data.size()) {
+                    auto const c = this->data[this->pos];
+                    if (not statement_specials[static_cast<unsigned char>(c)]) {
+                        ++this->pos;
+                        continue;
+                    }
+
+                    switch (c) {
+                        case '<': {
+                            auto const end = this->data.find_first_of(">\n", this->pos + 1);
+                            this->pos = end == std::string_view::npos ? this->data.size() : end + 1;
+                            break;
+                        }
+                        case '"':
+                        case '\'': {
+                            this->skip_string(c);
+                            break;
+                        }
+                        case '#': {
+                            this->skip_comment();
+                            break;
+                        }
+                        case '\\': {
+                            this->pos += 2;
+                            break;
+                        }
+                        case '[':
+                        case '(': {
+                            ++depth;
+                            ++this->pos;
+                            break;
+                        }
+                        case ']':
+                        case ')': {
+                            if (depth > 0) {
+                                --depth;
+                            }
+                            ++this->pos;
+                            break;
+                        }
+                        default: {
+                            // '.'
+                            ++this->pos;
+                            if (depth == 0 and (this->pos >= this->data.size() or not continues_name(this->data[this->pos]))) {
+                                return this->pos;
+                            }
+                            break;
+                        }
+                    }
+                }
+                this->pos = this->data.size();
+                return this->pos;
+            }
+
+            /**
+             * Parses a prefix or base directive starting at pos and records it. pos is only moved if there is a directive.
+             * @return position right after the directive, std::nullopt if there is none
+             */
+            std::optional<size_t> scan_directive() {
+                auto const rest = this->data.substr(this->pos);
+
+                bool is_prefix;
+                bool sparql_syntax;
+                size_t p;
+                if (rest.starts_with("@prefix")) {
+                    is_prefix = true;
+                    sparql_syntax = false;
+                    p = 7;
+                } else if (rest.starts_with("@base")) {
+                    is_prefix = false;
+                    sparql_syntax = false;
+                    p = 5;
+                } else if (iequals(rest.substr(0, 6), "prefix")) {
+                    is_prefix = true;
+                    sparql_syntax = true;
+                    p = 6;
+                } else if (iequals(rest.substr(0, 4), "base")) {
+                    is_prefix = false;
+                    sparql_syntax = true;
+                    p = 4;
+                } else {
+                    return std::nullopt;
+                }
+
+                auto const skip_space = [&rest, &p] {
+                    while (p < rest.size() and is_space(rest[p])) {
+                        ++p;
+                    }
+                };
+                if (p >= rest.size() or not is_space(rest[p])) {
+                    return std::nullopt;
+                }
+                skip_space();
+
+                std::string_view name;
+                if (is_prefix) {
+                    auto const colon = rest.find(':', p);
+                    if (colon == std::string_view::npos) {
+                        return std::nullopt;
+                    }
+                    name = rest.substr(p, colon - p);
+                    if (std::ranges::any_of(name, [](char const c) { return is_space(c) or c == '<'; })) {
+                        return std::nullopt;
+                    }
+                    p = colon + 1;
+                    skip_space();
+                }
+
+                if (p >= rest.size() or rest[p] != '<') {
+                    return std::nullopt;
+                }
+                auto const iri_end = rest.find_first_of(">\n", p + 1);
+                if (iri_end == std::string_view::npos or rest[iri_end] != '>') {
+                    return std::nullopt;
+                }
+                this->prefixes.emplace(std::string{name}, std::string{rest.substr(p + 1, iri_end - p - 1)});
+
+                this->pos += iri_end + 1;
+                if (sparql_syntax) {
+                    return this->pos;
+                }
+                return this->scan_statement();
+            }
+
+        public:
+            explicit StatementScanner(std::string_view const data) noexcept : data{data} {
+            }
+
+            [[nodiscard]] size_t position() const noexcept {
+                return this->pos;
+            }
+
+            [[nodiscard]] PrefixMap const &prefix_map() const noexcept {
+                return this->prefixes;
+            }
+
+            /**
+             * Advances past the next statement or directive and the space and comments that follow it.
+             * @return position of the statement after it, or the end of data
+             */
+            size_t next_statement() {
+                this->skip_space_and_comments();
+                if (this->pos >= this->data.size()) {
+                    return this->pos;
+                }
+                if (not this->scan_directive().has_value()) {
+                    this->scan_statement();
+                }
+                this->skip_space_and_comments();
+                return this->pos;
+            }
+        };
+
+    }  // namespace
+
+    std::vector<TurtleChunk> split_at_statements(std::filesystem::path const &path, size_t const n) {
+        dictionary::MappedFile const file{path};
+        std::string_view const data{reinterpret_cast<char const *>(file.bytes().data()), file.size()};
+
+        std::vector<TurtleChunk> chunks;
+        chunks.push_back(TurtleChunk{.range = io::FileRange{.path = path, .begin = 0, .end = data.size()}, .prefixes = {}});
+
+        // the statements after the last split need not be scanned
+        StatementScanner scanner{data};
+        for (size_t i = 1; i < n; ++i) {
+            auto const target = data.size() * i / n;
+            while (scanner.position() < target) {
+                scanner.next_statement();
+            }
+
+            auto const end = scanner.position();
+            if (end >= data.size()) {
+                break;
+            }
+            if (end > chunks.back().range.begin) {
+                chunks.back().range.end = end;
+                chunks.push_back(TurtleChunk{.range = io::FileRange{.path = path, .begin = end, .end = data.size()},
+                                             .prefixes = scanner.prefix_map()});
+            }
+        }
+        return chunks;
+    }
+
+}  // namespace rdf4cpp::rdftools::parser
@@ -0,0 +1,41 @@
+#ifndef RDFTOOLS_TURTLESPLITTER_HPP
+#define RDFTOOLS_TURTLESPLITTER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+#include <io/FileRange.hpp>
+#include <parser/IStreamQuadIterator.hpp>
+
+namespace rdf4cpp::rdftools::parser {
+
+/**
+ * Part of a Turtle file that can be parsed on its own.
+ */
+struct TurtleChunk {
+    io::FileRange range;
+    /**
+     * Prefixes (and base) declared before range. Pass them to IStreamQuadIterator to parse the chunk.
+     */
+    IStreamQuadIterator::prefix_storage_type prefixes;
+};
+
+/**
+ * Splits a Turtle file into at most n chunks of similar size. Each chunk except the first starts with a statement, so a chunk never consists
+ * of only space and comments.
+ *
+ * The file is scanned once. The scan skips over IRIs, short and long strings and comments, so that only a '.' that
+ * terminates a statement (outside of [] and ()) or the end of a SPARQL-style PREFIX or BASE directive is used as boundary.
+ * Along the way, the prefix and base directives are recorded exactly as IStreamQuadIterator records them:
+ * the base as prefix "" and the first declaration of a name wins.
+ *
+ * @note N-Triples is a subset of Turtle, but io::split_at_line_breaks() is cheaper for it.
+ * @note Chunks are only guaranteed to be independent for syntactically valid input.
+ * @throws std::runtime_error if the file cannot be read
+ */
+std::vector<TurtleChunk> split_at_statements(std::filesystem::path const &path, size_t n);
+
+}  // namespace rdf4cpp::rdftools::parser
+
+#endif  // RDFTOOLS_TURTLESPLITTER_HPP
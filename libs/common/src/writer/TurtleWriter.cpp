@@ -0,0 +1,325 @@
+#include <writer/TurtleWriter.hpp>
+
+#include <algorithm>
+#include <cctype>
+
+#include <fmt/format.h>
+
+namespace rdf4cpp::rdftools::writer {
+
+    namespace {
+
+        constexpr std::string_view rdf_type = "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>";
+        constexpr std::string_view xsd_integer = "<http://www.w3.org/2001/XMLSchema#integer>";
+        constexpr std::string_view xsd_decimal = "<http://www.w3.org/2001/XMLSchema#decimal>";
+        constexpr std::string_view xsd_boolean = "<http://www.w3.org/2001/XMLSchema#boolean>";
+
+        /**
+         * Conventional names of common namespaces. Learned namespaces get these names instead of generated ones.
+         */
+        constexpr std::array<std::pair<std::string_view, std::string_view>, 12> well_known_prefixes{{
+                {"rdf", "http://www.w3.org/1999/02/22-rdf-syntax-ns#"},
+                {"rdfs", "http://www.w3.org/2000/01/rdf-schema#"},
+                {"xsd", "http://www.w3.org/2001/XMLSchema#"},
+                {"owl", "http://www.w3.org/2002/07/owl#"},
+                {"foaf", "http://xmlns.com/foaf/0.1/"},
+                {"dc", "http://purl.org/dc/elements/1.1/"},
+                {"dcterms", "http://purl.org/dc/terms/"},
+                {"skos", "http://www.w3.org/2004/02/skos/core#"},
+                {"prov", "http://www.w3.org/ns/prov#"},
+                {"schema", "http://schema.org/"},
+                {"dbo", "http://dbpedia.org/ontology/"},
+                {"dbr", "http://dbpedia.org/resource/"},
+        }};
+
+        /**
+         * Characters that may appear anywhere in a local name. Restricted to ASCII and without escapes to stay on the safe side.
+         */
+        bool is_local_char(char const c) noexcept {
+            return std::isalnum(static_cast<unsigned char>(c)) or c == '_' or c == '-' or c == '.' or c == ':';
+        }
+
+        /**
+         * Checks if local is a valid PN_LOCAL (see above) that can be written without escapes.
+         */
+        bool is_valid_local(std::string_view const local) noexcept {
+            if (local.empty()) {
+                return true;
+            }
+            if (local.front() == '-' or local.front() == '.' or local.back() == '.') {
+                return false;
+            }
+            return std::ranges::all_of(local, is_local_char);
+        }
+
+        /**
+         * @return the namespace of iri (without '<' '>'), i.e. everything up to the last '/' or '#', or an empty view if the rest is no valid local name.
+         */
+        std::string_view namespace_of(std::string_view const iri) noexcept {
+            auto const pos = iri.find_last_of("/#");
+            if (pos == std::string_view::npos or not is_valid_local(iri.substr(pos + 1))) {
+                return {};
+            }
+            return iri.substr(0, pos + 1);
+        }
+
+        bool is_integer(std::string_view lexical) noexcept {
+            if (not lexical.empty() and (lexical.front() == '+' or lexical.front() == '-')) {
+                lexical.remove_prefix(1);
+            }
+            return not lexical.empty() and std::ranges::all_of(lexical, [](char const c) { return std::isdigit(static_cast<unsigned char>(c)); });
+        }
+
+        bool is_decimal(std::string_view lexical) noexcept {
+            if (not lexical.empty() and (lexical.front() == '+' or lexical.front() == '-')) {
+                lexical.remove_prefix(1);
+            }
+            auto const dot = lexical.find('.');
+            if (dot == std::string_view::npos) {
+                return false;
+            }
+            auto const is_digits = [](std::string_view const digits) {
+                return std::ranges::all_of(digits, [](char const c) { return std::isdigit(static_cast<unsigned char>(c)); });
+            };
+            return is_digits(lexical.substr(0, dot)) and dot + 1 < lexical.size() and is_digits(lexical.substr(dot + 1));
+        }
+
+    }  // namespace
+
+    TurtleWriter::TurtleWriter(std::ostream &out, Options options)
+        : out{out},
+          options{options} {
+        this->held_back.reserve(std::min(this->options.learning_triples, size_t{1} << 16));
+    }
+
+    void TurtleWriter::declare_prefix(std::string_view const name, std::string_view const namespace_iri) {
+        if (this->namespaces.find(name) != this->namespaces.end() or this->prefix_names.find(namespace_iri) != this->prefix_names.end()) {
+            return;
+        }
+        this->namespaces.emplace(std::string{name}, std::string{namespace_iri});
+        this->prefix_names.emplace(std::string{namespace_iri}, std::string{name});
+
+        if (this->header_written) {
+            // Turtle allows declaring prefixes between statements
+            this->end_statement();
+            this->append_prefix_declaration(name, namespace_iri);
+            this->flush_buffer();
+        } else {
+            this->header_prefixes.emplace_back(name, namespace_iri);
+        }
+    }
+
+    void TurtleWriter::learn(std::string_view const term) {
+        std::string_view iri;
+        if (term.starts_with('<')) {
+            iri = term.substr(1, term.size() - 2);
+        } else if (term.starts_with('"') and term.ends_with('>')) {
+            if (auto const pos = term.rfind("\"^^<"); pos != std::string_view::npos) {
+                iri = term.substr(pos + 4, term.size() - pos - 5);
+            }
+        }
+
+        if (auto const ns = namespace_of(iri); not ns.empty()) {
+            this->learning_key.assign(ns);
+            if (auto it = this->namespace_uses.find(this->learning_key); it != this->namespace_uses.end()) {
+                ++it->second;
+            } else {
+                this->namespace_uses.emplace(this->learning_key, 1);
+            }
+        }
+    }
+
+    void TurtleWriter::learn_prefixes() {
+        // bytes saved by a prefix with a name of typical length, minus the cost of its declaration
+        auto const savings = [](std::string_view const ns, size_t const uses) -> int64_t {
+            static constexpr int64_t name_size = 4;
+            auto const ns_size = static_cast<int64_t>(ns.size());
+            return static_cast<int64_t>(uses) * (ns_size + 2 - name_size - 1) - (ns_size + name_size + 15);
+        };
+
+        std::vector<std::pair<std::string_view, int64_t>> candidates;
+        for (auto const &[ns, uses] : this->namespace_uses) {
+            if (this->prefix_names.find(std::string_view{ns}) == this->prefix_names.end() and savings(ns, uses) > 0) {
+                candidates.emplace_back(ns, savings(ns, uses));
+            }
+        }
+        std::ranges::sort(candidates, std::ranges::greater{}, &std::pair<std::string_view, int64_t>::second);
+        if (candidates.size() > this->options.max_learned_prefixes) {
+            candidates.resize(this->options.max_learned_prefixes);
+        }
+
+        size_t generated_names = 0;
+        for (auto const &[ns, _] : candidates) {
+            auto const well_known = std::ranges::find(well_known_prefixes, ns, &std::pair<std::string_view, std::string_view>::second);
+            if (well_known != well_known_prefixes.end() and this->namespaces.find(well_known->first) == this->namespaces.end()) {
+                this->declare_prefix(well_known->first, ns);
+                continue;
+            }
+
+            std::string name;
+            do {
+                name = fmt::format("ns{}", ++generated_names);
+            } while (this->namespaces.find(std::string_view{name}) != this->namespaces.end());
+            this->declare_prefix(name, ns);
+        }
+
+        this->namespace_uses.clear();
+    }
+
+    void TurtleWriter::write_header() {
+        for (auto const &[name, ns] : this->header_prefixes) {
+            this->append_prefix_declaration(name, ns);
+        }
+        if (not this->header_prefixes.empty()) {
+            this->buffer.push_back('\n');
+        }
+        this->header_prefixes.clear();
+        this->header_written = true;
+        this->flush_buffer();
+    }
+
+    void TurtleWriter::append_prefix_declaration(std::string_view const name, std::string_view const namespace_iri) {
+        this->buffer.append("@prefix ");
+        this->buffer.append(name);
+        this->buffer.append(": <");
+        this->buffer.append(namespace_iri);
+        this->buffer.append("> .\n");
+    }
+
+    void TurtleWriter::append_iri(std::string_view const iri) {
+        auto const content = iri.substr(1, iri.size() - 2);
+
+        // try the namespaces that end at '/', '#' or ':' in the last path segment, the most specific one first
+        for (size_t pos = content.size(); pos > 0; --pos) {
+            auto const c = content[pos - 1];
+            if (c == '/' or c == '#' or c == ':') {
+                auto const local = content.substr(pos);
+                if (is_valid_local(local)) {
+                    if (auto const it = this->prefix_names.find(content.substr(0, pos)); it != this->prefix_names.end()) {
+                        this->buffer.append(it->second);
+                        this->buffer.push_back(':');
+                        this->buffer.append(local);
+                        return;
+                    }
+                }
+                if (c != ':') {
+                    break;
+                }
+            } else if (not is_local_char(c)) {
+                break;
+            }
+        }
+        this->buffer.append(iri);
+    }
+
+    void TurtleWriter::append_term(std::string_view const term) {
+        if (term.starts_with('<')) {
+            this->append_iri(term);
+            return;
+        }
+
+        if (term.starts_with('"') and term.ends_with('>')) {
+            if (auto const pos = term.rfind("\"^^<"); pos != std::string_view::npos) {
+                auto const lexical = term.substr(1, pos - 1);
+                auto const datatype = term.substr(pos + 3);
+                if ((datatype == xsd_integer and is_integer(lexical)) or
+                    (datatype == xsd_decimal and is_decimal(lexical)) or
+                    (datatype == xsd_boolean and (lexical == "true" or lexical == "false"))) {
+                    this->buffer.append(lexical);
+                } else {
+                    this->buffer.append(term.substr(0, pos + 1));
+                    this->buffer.append("^^");
+                    this->append_iri(datatype);
+                }
+                return;
+            }
+        }
+
+        // blank nodes, plain and language-tagged literals
+        this->buffer.append(term);
+    }
+
+    void TurtleWriter::append_predicate(std::string_view const p) {
+        if (p == rdf_type) {
+            this->buffer.push_back('a');
+        } else {
+            this->append_iri(p);
+        }
+    }
+
+    void TurtleWriter::append_triple(std::string_view const s, std::string_view const p, std::string_view const o) {
+        if (this->in_statement and s == this->subject) {
+            if (p == this->predicate) {
+                this->buffer.append(" ,\n        ");
+            } else {
+                this->buffer.append(" ;\n    ");
+                this->append_predicate(p);
+                this->buffer.push_back(' ');
+                this->predicate.assign(p);
+            }
+        } else {
+            this->end_statement();
+            this->append_term(s);
+            this->buffer.push_back(' ');
+            this->append_predicate(p);
+            this->buffer.push_back(' ');
+            this->subject.assign(s);
+            this->predicate.assign(p);
+            this->in_statement = true;
+        }
+        this->append_term(o);
+    }
+
+    void TurtleWriter::end_statement() {
+        if (this->in_statement) {
+            this->buffer.append(" .\n");
+            this->in_statement = false;
+        }
+    }
+
+    void TurtleWriter::flush_buffer() {
+        if (not this->buffer.empty()) {
+            this->out.write(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+            this->buffer.clear();
+        }
+    }
+
+    void TurtleWriter::write(std::string_view const s, std::string_view const p, std::string_view const o) {
+        if (not this->header_written) [[unlikely]] {
+            if (this->held_back.size() < this->options.learning_triples) {
+                this->held_back.push_back({std::string{s}, std::string{p}, std::string{o}});
+                this->learn(s);
+                this->learn(p);
+                this->learn(o);
+                return;
+            }
+            this->finish_learning();
+        }
+
+        this->append_triple(s, p, o);
+        this->flush_buffer();
+    }
+
+    void TurtleWriter::finish_learning() {
+        this->learn_prefixes();
+        this->write_header();
+        for (auto const &[s, p, o] : this->held_back) {
+            this->append_triple(s, p, o);
+            if (this->buffer.size() >= flush_threshold) {
+                this->flush_buffer();
+            }
+        }
+        this->flush_buffer();
+        this->held_back.clear();
+        this->held_back.shrink_to_fit();
+    }
+
+    void TurtleWriter::finish() {
+        if (not this->header_written) {
+            this->finish_learning();
+        }
+        this->end_statement();
+        this->flush_buffer();
+    }
+
+}  // namespace rdf4cpp::rdftools::writer
@@ -0,0 +1,117 @@
+#ifndef RDFTOOLS_TURTLEWRITER_HPP
+#define RDFTOOLS_TURTLEWRITER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <rdf4cpp/rdf/storage/util/robin-hood-hashing/robin_hood_hash.hpp>
+#include <rdf4cpp/rdf/storage/util/tsl/sparse_map.h>
+
+namespace rdf4cpp::rdftools::writer {
+
+/**
+ * Serializes triples as Turtle.
+ *
+ * IRIs are abbreviated to CURIEs if a matching prefix is known. Prefixes come from two sources:
+ *  - declare_prefix(), e.g. with the prefixes of the input (IStreamQuadIterator::prefixes()). They can be declared at any time.
+ *  - learning: the first Options::learning_triples triples are held back and the most frequent namespaces among them
+ *    get a prefix, if that makes the output smaller.
+ * Consecutive triples with the same subject are grouped with ';', with the same subject and predicate with ','.
+ * rdf:type is written as 'a', and xsd:integer, xsd:decimal and xsd:boolean literals in their short form.
+ *
+ * Each statement is assembled in a reusable buffer and handed to the stream buffer of out in one piece,
+ * so that writing does not allocate once the buffers are warmed up.
+ *
+ * @note terms must be given in N-Triples syntax, as produced by IStreamQuadIterator
+ */
+class TurtleWriter {
+public:
+    struct Options {
+        /**
+         * Number of leading triples that are held back to learn frequent namespaces. 0 disables learning.
+         */
+        size_t learning_triples = 10'000;
+        size_t max_learned_prefixes = 32;
+    };
+
+private:
+    using string_map_type = rdf4cpp::rdf::storage::util::tsl::sparse_map<
+            std::string,
+            std::string,
+            rdf4cpp::rdf::storage::util::robin_hood::hash<std::string_view>,
+            std::equal_to<>>;
+
+    // held back triples are written in chunks of this size
+    static constexpr size_t flush_threshold = 1UL << 16;
+
+    std::ostream &out;
+    Options options;
+
+    // prefix name -> namespace IRI
+    string_map_type namespaces;
+    // namespace IRI -> prefix name
+    string_map_type prefix_names;
+    // prefixes in declaration order, for the header
+    std::vector<std::pair<std::string, std::string>> header_prefixes;
+    bool header_written = false;
+
+    std::vector<std::array<std::string, 3>> held_back;
+    std::unordered_map<std::string, size_t> namespace_uses;
+    std::string learning_key;
+
+    std::string subject;
+    std::string predicate;
+    bool in_statement = false;
+    std::string buffer;
+
+    void learn(std::string_view term);
+    void learn_prefixes();
+    void write_header();
+    void finish_learning();
+
+    void append_prefix_declaration(std::string_view name, std::string_view namespace_iri);
+    void append_iri(std::string_view iri);
+    void append_predicate(std::string_view p);
+    void append_term(std::string_view term);
+    void append_triple(std::string_view s, std::string_view p, std::string_view o);
+    void end_statement();
+    void flush_buffer();
+
+public:
+    /**
+     * @param out stream to write to
+     * @param options see Options
+     */
+    TurtleWriter(std::ostream &out, Options options);
+
+    TurtleWriter(TurtleWriter const &) = delete;
+    TurtleWriter &operator=(TurtleWriter const &) = delete;
+
+    /**
+     * Makes name available for abbreviating IRIs in namespace_iri. Ignored if name or namespace_iri already has a prefix.
+     * @param name prefix name without ':'
+     * @param namespace_iri namespace IRI without '<' '>'
+     */
+    void declare_prefix(std::string_view name, std::string_view namespace_iri);
+
+    /**
+     * Writes a triple. Terms are given in N-Triples syntax.
+     */
+    void write(std::string_view s, std::string_view p, std::string_view o);
+
+    /**
+     * Writes held back triples and terminates the last statement. Must be called after the last triple.
+     */
+    void finish();
+};
+
+}  // namespace rdf4cpp::rdftools::writer
+
+#endif  // RDFTOOLS_TURTLEWRITER_HPP
@@ -0,0 +1,59 @@
+#ifndef RDFTOOLS_TEMPDIRECTORY_HPP
+#define RDFTOOLS_TEMPDIRECTORY_HPP
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace rdf4cpp::rdftools::tests {
+
+/**
+ * Fresh directory below the system's temporary directory. It is removed with all its content on destruction.
+ */
+class TempDirectory {
+    std::filesystem::path path_;
+
+public:
+    TempDirectory()
+        : path_{std::filesystem::temp_directory_path() / ("rdftools-tests-" + std::to_string(std::random_device{}()))} {
+        if (not std::filesystem::create_directory(this->path_)) {
+            throw std::runtime_error{"temporary directory " + this->path_.string() + " exists already"};
+        }
+    }
+
+    TempDirectory(TempDirectory const &) = delete;
+    TempDirectory &operator=(TempDirectory const &) = delete;
+
+    ~TempDirectory() noexcept {
+        std::error_code ec;
+        std::filesystem::remove_all(this->path_, ec);
+    }
+
+    [[nodiscard]] std::filesystem::path const &path() const noexcept {
+        return this->path_;
+    }
+
+    /**
+     * @return path of the new file
+     */
+    std::filesystem::path write_file(std::string_view const name, std::string_view const content) const {
+        auto path = this->path_ / name;
+        std::ofstream ofs{path, std::ios::binary | std::ios::trunc};
+        ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+        return path;
+    }
+};
+
+inline std::string read_file(std::filesystem::path const &path) {
+    std::ifstream ifs{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+}
+
+}  // namespace rdf4cpp::rdftools::tests
+
+#endif  // RDFTOOLS_TEMPDIRECTORY_HPP
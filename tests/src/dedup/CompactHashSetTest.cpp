@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <dedup/CompactHashSet.hpp>
+
+using rdf4cpp::rdftools::dedup::CompactHashSet;
+
+namespace {
+
+    /**
+     * Inserts hashes into a CompactHashSet and a std::set and checks that both agree on every insert and lookup.
+     */
+    void expect_same_as_std_set(std::vector<uint64_t> const &hashes) {
+        CompactHashSet set;
+        std::set<uint64_t> expected;
+        for (auto const hash : hashes) {
+            ASSERT_EQ(set.insert(hash), expected.insert(hash).second) << "hash " << hash;
+        }
+        ASSERT_EQ(set.size(), expected.size());
+
+        for (auto const hash : expected) {
+            ASSERT_TRUE(set.contains(hash)) << "hash " << hash;
+        }
+        std::mt19937_64 rng{7};
+        for (size_t i = 0; i < 10'000; ++i) {
+            auto const hash = rng();
+            ASSERT_EQ(set.contains(hash), expected.contains(hash)) << "hash " << hash;
+        }
+    }
+
+}  // namespace
+
+TEST(CompactHashSetTest, UniformHashes) {
+    std::mt19937_64 rng{42};
+    std::vector<uint64_t> hashes;
+    for (size_t i = 0; i < 300'000; ++i) {
+        hashes.push_back(rng());
+        if (i % 3 == 0) {
+            // a duplicate of an earlier hash
+            hashes.push_back(hashes[rng() % hashes.size()]);
+        }
+    }
+    expect_same_as_std_set(hashes);
+}
+
+TEST(CompactHashSetTest, ExtremeHashes) {
+    std::vector<uint64_t> hashes{0, 1, 2, UINT64_MAX, UINT64_MAX - 1, uint64_t{1} << 63, (uint64_t{1} << 63) - 1, 0, UINT64_MAX};
+    // dense clusters need small deltas, sparse ones large deltas
+    for (uint64_t i = 0; i < 5000; ++i) {
+        hashes.push_back(i);
+        hashes.push_back(UINT64_MAX - 3 * i);
+        hashes.push_back(i * 0x9E3779B97F4A7C15ULL);
+    }
+    expect_same_as_std_set(hashes);
+}
+
+TEST(CompactHashSetTest, GrowsOneBucketAtATime) {
+    CompactHashSet set;
+    std::mt19937_64 rng{1};
+    std::vector<uint64_t> hashes(1'000'000);
+    for (auto &hash : hashes) {
+        hash = rng();
+        set.insert(hash);
+        // every hash inserted so far must be found while buckets are split
+        ASSERT_TRUE(set.contains(hashes[rng() % static_cast<size_t>(&hash - hashes.data() + 1)]));
+    }
+    EXPECT_EQ(set.size(), hashes.size());
+    for (auto const hash : hashes) {
+        ASSERT_FALSE(set.insert(hash));
+    }
+}
+
+TEST(CompactHashSetTest, MemoryPerEntry) {
+    CompactHashSet set;
+    std::mt19937_64 rng{3};
+    for (size_t i = 0; i < 1'000'000; ++i) {
+        set.insert(rng());
+    }
+    EXPECT_LT(static_cast<double>(set.memory_usage()) / static_cast<double>(set.size()), 8.0);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <dedup/WindowedHashSet.hpp>
+
+using rdf4cpp::rdftools::dedup::WindowedHashSet;
+
+namespace {
+
+    uint64_t nth_hash(uint64_t const n) noexcept {
+        return n * 0x9E3779B97F4A7C15ULL + 1;
+    }
+
+}  // namespace
+
+TEST(WindowedHashSetTest, RemembersTheWindowAndForgetsOlderHashes) {
+    for (size_t const generations : {2UL, 4UL, 7UL}) {
+        WindowedHashSet set{100, generations};
+        auto const window = set.window();
+        ASSERT_GE(window, 100);
+        // all generations together hold at most this many hashes
+        auto const capacity = window + window / (generations - 1);
+
+        // many more insertions than generations * 256, so that the 8-bit epochs wrap around
+        for (uint64_t n = 0; n < 300 * capacity; ++n) {
+            ASSERT_TRUE(set.insert(nth_hash(n))) << "n " << n;
+            ASSERT_FALSE(set.insert(nth_hash(n)));
+            if (n >= window) {
+                ASSERT_TRUE(set.contains(nth_hash(n - window + 1))) << "n " << n;
+            }
+            if (n >= capacity) {
+                ASSERT_FALSE(set.contains(nth_hash(n - capacity))) << "n " << n;
+            }
+            ASSERT_LE(set.size(), capacity);
+        }
+        EXPECT_GE(set.size(), window);
+    }
+}
+
+TEST(WindowedHashSetTest, EvictedHashesCanBeInsertedAgain) {
+    WindowedHashSet set{10, 2};
+    for (uint64_t round = 0; round < 3; ++round) {
+        for (uint64_t n = 0; n < 100; ++n) {
+            EXPECT_TRUE(set.insert(nth_hash(n))) << "round " << round << " n " << n;
+        }
+    }
+}
+
+TEST(WindowedHashSetTest, MemoryBudget) {
+    for (size_t const budget : {1000UL, 1UL << 20}) {
+        auto const set = WindowedHashSet::with_memory_budget(budget);
+        EXPECT_LE(set.memory_usage(), budget);
+        EXPECT_GT(set.window(), 0);
+    }
+    EXPECT_THROW((void) WindowedHashSet::with_memory_budget(1), std::invalid_argument);
+}
+
+TEST(WindowedHashSetTest, RejectsInvalidArguments) {
+    EXPECT_THROW(WindowedHashSet{0}, std::invalid_argument);
+    EXPECT_THROW((WindowedHashSet{10, 1}), std::invalid_argument);
+}
@@ -0,0 +1,139 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <dictionary/DictionaryReader.hpp>
+#include <dictionary/DictionaryWriter.hpp>
+
+#include <TempDirectory.hpp>
+
+using namespace rdf4cpp::rdftools::dictionary;
+using rdf4cpp::rdftools::tests::read_file;
+using rdf4cpp::rdftools::tests::TempDirectory;
+
+namespace {
+
+    /**
+     * Triples with shared prefixes, repeated terms and terms of very different length.
+     */
+    std::vector<StringTriple> make_triples(size_t const n) {
+        std::mt19937_64 rng{42};
+        std::vector<StringTriple> triples;
+        triples.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            triples.push_back({"<http://example.org/s/" + std::to_string(rng() % 500) + ">",
+                               "<http://example.org/p" + std::to_string(rng() % 7) + ">",
+                               rng() % 2 == 0 ? "\"literal " + std::to_string(rng() % 3000) + "\"@en"
+                                              : "<http://example.org/o/" + std::string(rng() % 40, 'x') + ">"});
+        }
+        return triples;
+    }
+
+    void write_dictionary(std::filesystem::path const &path, std::vector<StringTriple> const &triples,
+                          uint32_t const block_size = default_block_size,
+                          size_t const memory_limit = DictionaryWriter::default_memory_limit) {
+        DictionaryWriter writer{path, block_size, memory_limit};
+        for (auto const &[s, p, o] : triples) {
+            writer.add(s, p, o);
+        }
+        writer.finish();
+    }
+
+    std::vector<StringTriple> read_dictionary(std::filesystem::path const &path) {
+        DictionaryReader const reader{path};
+        std::vector<StringTriple> triples;
+        for (auto const &triple : reader) {
+            triples.push_back(triple);
+        }
+        return triples;
+    }
+
+}  // namespace
+
+TEST(DictionaryTest, RoundTrip) {
+    TempDirectory const dir;
+    auto const triples = make_triples(5000);
+
+    for (uint32_t const block_size : {1U, 3U, default_block_size}) {
+        write_dictionary(dir.path() / "dataset", triples, block_size);
+        EXPECT_EQ(read_dictionary(dir.path() / "dataset"), triples) << "block size " << block_size;
+    }
+}
+
+TEST(DictionaryTest, TermsAreSortedAndFindable) {
+    TempDirectory const dir;
+    auto const triples = make_triples(2000);
+    write_dictionary(dir.path() / "dataset", triples);
+
+    std::set<std::string> terms;
+    for (auto const &triple : triples) {
+        terms.insert(triple.begin(), triple.end());
+    }
+
+    DictionaryReader const reader{dir.path() / "dataset"};
+    auto const &dictionary = reader.dictionary();
+    ASSERT_EQ(dictionary.size(), terms.size());
+    EXPECT_EQ(reader.id_triples().id_width(), sizeof(uint32_t));
+
+    uint64_t id = 0;
+    for (auto const &term : terms) {
+        EXPECT_EQ(dictionary.term(id), term);
+        EXPECT_EQ(dictionary.find(term), id);
+        ++id;
+    }
+    EXPECT_EQ(dictionary.find("<http://example.org/missing>"), std::nullopt);
+    EXPECT_EQ(dictionary.find(""), std::nullopt);
+    EXPECT_THROW((void) dictionary.term(dictionary.size()), std::out_of_range);
+}
+
+TEST(DictionaryTest, SpilledRunsGiveTheSameFiles) {
+    TempDirectory const dir;
+    auto const triples = make_triples(5000);
+    write_dictionary(dir.path() / "in_memory", triples);
+
+    for (size_t const memory_limit : {1UL, 1000UL, 100'000UL}) {
+        write_dictionary(dir.path() / "spilled", triples, default_block_size, memory_limit);
+        EXPECT_EQ(read_file(dir.path() / "spilled.dict"), read_file(dir.path() / "in_memory.dict")) << "memory limit " << memory_limit;
+        EXPECT_EQ(read_file(dir.path() / "spilled.ids"), read_file(dir.path() / "in_memory.ids")) << "memory limit " << memory_limit;
+    }
+
+    // only the output files are left
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator{dir.path()}, std::filesystem::directory_iterator{}), 4);
+}
+
+TEST(DictionaryTest, EmptyDataset) {
+    TempDirectory const dir;
+    write_dictionary(dir.path() / "dataset", {});
+
+    DictionaryReader const reader{dir.path() / "dataset"};
+    EXPECT_EQ(reader.size(), 0);
+    EXPECT_EQ(reader.dictionary().size(), 0);
+    EXPECT_TRUE(reader.begin() == reader.end());
+}
+
+TEST(DictionaryTest, UnfinishedWriterLeavesNoTemporaryFiles) {
+    TempDirectory const dir;
+    {
+        DictionaryWriter writer{dir.path() / "dataset", default_block_size, 1};
+        for (auto const &[s, p, o] : make_triples(100)) {
+            writer.add(s, p, o);
+        }
+    }
+    EXPECT_TRUE(std::filesystem::is_empty(dir.path()));
+}
+
+TEST(DictionaryTest, RejectsOtherFiles) {
+    TempDirectory const dir;
+    write_dictionary(dir.path() / "dataset", make_triples(10));
+
+    EXPECT_THROW(Dictionary{dir.path() / "dataset.ids"}, std::runtime_error);
+    EXPECT_THROW(IdTriples{dir.path() / "dataset.dict"}, std::runtime_error);
+    EXPECT_THROW(Dictionary{dir.write_file("empty.dict", "")}, std::runtime_error);
+    EXPECT_THROW(DictionaryReader{dir.path() / "missing"}, std::runtime_error);
+}
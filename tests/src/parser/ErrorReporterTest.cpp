@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <io/LineTrackingStreambuf.hpp>
+#include <parser/ErrorReporter.hpp>
+
+#include <TempDirectory.hpp>
+
+using namespace rdf4cpp::rdftools;
+using parser::ErrorReporter;
+using parser::ParsingError;
+using tests::read_file;
+using tests::TempDirectory;
+
+namespace {
+
+    ParsingError error_at(ParsingError::Type const type, uint64_t const line) {
+        return ParsingError{.error_type = type, .line = line, .col = 1, .message = "test error"};
+    }
+
+}  // namespace
+
+TEST(ErrorReporterTest, LimitsMessagesPerType) {
+    ErrorReporter reporter{ErrorReporter::Options{.max_reports_per_type = 3}};
+    auto const filter = reporter.error_message_filter();
+
+    for (uint64_t i = 0; i < 10; ++i) {
+        EXPECT_EQ(reporter.wants_message(ParsingError::Type::BadSyntax), i < 3) << "error " << i;
+        EXPECT_EQ(filter(ParsingError::Type::BadSyntax), i < 3) << "error " << i;
+        reporter.report(error_at(ParsingError::Type::BadSyntax, i + 1));
+    }
+
+    // the limit of one type does not affect the others
+    EXPECT_TRUE(reporter.wants_message(ParsingError::Type::BadIri));
+    reporter.report(error_at(ParsingError::Type::BadIri, 11));
+
+    EXPECT_EQ(reporter.num_errors(), 11);
+    reporter.finish();
+}
+
+TEST(ErrorReporterTest, NoLimitByDefault) {
+    ErrorReporter reporter{ErrorReporter::Options{}};
+    for (uint64_t i = 0; i < 1000; ++i) {
+        reporter.report(error_at(ParsingError::Type::BadLiteral, i + 1));
+    }
+    EXPECT_TRUE(reporter.wants_message(ParsingError::Type::BadLiteral));
+    EXPECT_EQ(reporter.num_errors(), 1000);
+}
+
+TEST(ErrorReporterTest, CountsFromSeveralThreads) {
+    ErrorReporter reporter{ErrorReporter::Options{.max_reports_per_type = 0, .summary_interval = std::chrono::seconds{0}}};
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&reporter] {
+            for (uint64_t i = 0; i < 1000; ++i) {
+                reporter.count_parsed(10);
+                reporter.report(error_at(ParsingError::Type::BadSyntax, i + 1));
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(reporter.num_errors(), 4000);
+}
+
+TEST(ErrorReporterTest, QuarantinesEachRejectedLineOnce) {
+    TempDirectory const dir;
+    auto const quarantine_path = dir.path() / "rejected.nt";
+
+    std::istringstream source{"<a> <b> <c> .\n"
+                              "broken line\n"
+                              "<a> <b> <d> .\n"
+                              "another broken line\r\n"
+                              "<a> <b> <e> .\n"};
+    io::LineTrackingStreambuf tracking{source.rdbuf()};
+    std::istream in{&tracking};
+    std::string const consumed{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    ASSERT_EQ(consumed.size(), source.str().size());
+
+    {
+        ErrorReporter reporter{ErrorReporter::Options{.max_reports_per_type = 1, .quarantine_path = quarantine_path}, &tracking};
+        reporter.report(error_at(ParsingError::Type::BadSyntax, 2));
+        // several errors in the same line
+        reporter.report(error_at(ParsingError::Type::BadSyntax, 4));
+        reporter.report(error_at(ParsingError::Type::BadIri, 4));
+        // a line that was never read
+        reporter.report(error_at(ParsingError::Type::BadSyntax, 100));
+        reporter.finish();
+    }
+
+    EXPECT_EQ(read_file(quarantine_path), "broken line\n"
+                                          "another broken line\n"
+                                          "# line 100 is not available anymore\n");
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <io/FileRange.hpp>
+#include <parser/TurtleSplitter.hpp>
+#include <writer/TurtleWriter.hpp>
+
+#include <TempDirectory.hpp>
+
+using namespace rdf4cpp::rdftools;
+using parser::split_at_statements;
+using parser::TurtleChunk;
+using tests::read_file;
+using tests::TempDirectory;
+
+namespace {
+
+    using Triple = std::array<std::string, 3>;
+
+    /**
+     * Checks that the chunks cover content without gaps and that no chunk starts with space or a comment.
+     */
+    void expect_contiguous_statements(std::vector<TurtleChunk> const &chunks, std::string const &content) {
+        ASSERT_FALSE(chunks.empty());
+        EXPECT_EQ(chunks.front().range.begin, 0);
+        EXPECT_EQ(chunks.back().range.end, content.size());
+        for (size_t i = 1; i < chunks.size(); ++i) {
+            EXPECT_EQ(chunks[i].range.begin, chunks[i - 1].range.end) << "chunk " << i;
+            EXPECT_LT(chunks[i].range.begin, chunks[i].range.end) << "chunk " << i;
+            EXPECT_EQ(std::string_view{" \t\r\n#"}.find(content[chunks[i].range.begin]), std::string_view::npos) << "chunk " << i;
+        }
+    }
+
+    std::vector<Triple> many_triples() {
+        std::vector<Triple> triples;
+        for (size_t i = 0; i < 1000; ++i) {
+            auto const subject = "<http://example.org/s" + std::to_string(i / 7) + ">";
+            triples.push_back({subject, "<http://example.org/p" + std::to_string(i % 3) + ">", "<http://example.org/o" + std::to_string(i) + ">"});
+            triples.push_back({subject, "<http://example.org/label>", "\"label. with dots.\"@en"});
+        }
+        return triples;
+    }
+
+    std::multiset<Triple> parse_chunks(std::vector<TurtleChunk> const &chunks) {
+        std::multiset<Triple> triples;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            io::FileRangeIStream in{chunks[i].range};
+            for (parser::IStreamQuadIterator qit{in, parser::ParsingFlags::none(), chunks[i].prefixes, {}, "_c" + std::to_string(i)};
+                 qit != parser::IStreamQuadIterator{}; ++qit) {
+                EXPECT_TRUE(qit->has_value()) << "chunk " << i << ": " << qit->error().message;
+                if (qit->has_value()) {
+                    auto const &quad = qit->value();
+                    triples.insert(Triple{std::string{quad[1].view()}, std::string{quad[2].view()}, std::string{quad[3].view()}});
+                }
+            }
+        }
+        return triples;
+    }
+
+}  // namespace
+
+TEST(TurtleSplitterTest, SplitsOnlyAtStatements) {
+    std::string content = "@prefix ex: <http://example.org/> .\n";
+    for (size_t i = 0; i < 200; ++i) {
+        auto const n = std::to_string(i);
+        content += "ex:s" + n + " ex:p <http://example.org/a.b.c/" + n + "> ;\n"
+                   "    ex:q \"short. string.\" , \"\"\"long.\n. string \"\" .\"\"\" ;\n"
+                   "    ex:r [ ex:p ex:o ] , ( ex:a ex:b.c ) . # a comment. with dots.\n";
+    }
+
+    TempDirectory const dir;
+    auto const path = dir.write_file("data.ttl", content);
+
+    for (size_t const n : {1UL, 2UL, 7UL, 64UL, 1000UL}) {
+        auto const chunks = split_at_statements(path, n);
+        EXPECT_LE(chunks.size(), n);
+        expect_contiguous_statements(chunks, content);
+        for (size_t i = 1; i < chunks.size(); ++i) {
+            // a '.' within an IRI, a string, a collection or a comment is not a boundary
+            EXPECT_EQ(content.substr(chunks[i].range.begin, 4), "ex:s") << "n " << n << " chunk " << i;
+        }
+    }
+    EXPECT_EQ(split_at_statements(path, 64).size(), 64);
+}
+
+TEST(TurtleSplitterTest, RecordsPrefixesBeforeEachChunk) {
+    std::string content = "@base <http://example.org/base/> .\n"
+                          "@prefix ex: <http://example.org/> .\n"
+                          "PREFIX other: <http://other.org/>\n";
+    for (size_t i = 0; i < 100; ++i) {
+        content += "ex:s" + std::to_string(i) + " ex:p other:o .\n";
+    }
+    content += "@prefix late: <http://late.org/> .\n"
+               "@prefix ex: <http://redeclared.org/> .\n";
+    for (size_t i = 0; i < 100; ++i) {
+        content += "late:s" + std::to_string(i) + " ex:p other:o .\n";
+    }
+
+    TempDirectory const dir;
+    auto const path = dir.write_file("data.ttl", content);
+    auto const chunks = split_at_statements(path, 4);
+    ASSERT_EQ(chunks.size(), 4);
+    expect_contiguous_statements(chunks, content);
+
+    EXPECT_TRUE(chunks[0].prefixes.empty());
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        auto const &prefixes = chunks[i].prefixes;
+        EXPECT_EQ(prefixes.at(""), "http://example.org/base/") << "chunk " << i;
+        EXPECT_EQ(prefixes.at("ex"), "http://example.org/") << "chunk " << i;
+        EXPECT_EQ(prefixes.at("other"), "http://other.org/") << "chunk " << i;
+    }
+    EXPECT_FALSE(chunks[1].prefixes.contains("late"));
+    EXPECT_EQ(chunks[3].prefixes.at("late"), "http://late.org/");
+}
+
+TEST(TurtleSplitterTest, SmallFileGivesOneChunk) {
+    TempDirectory const dir;
+    std::string const content = "<http://example.org/s> <http://example.org/p> \"o\" .\n";
+    auto const chunks = split_at_statements(dir.write_file("data.ttl", content), 8);
+    ASSERT_EQ(chunks.size(), 1);
+    EXPECT_EQ(chunks[0].range.begin, 0);
+    EXPECT_EQ(chunks[0].range.end, content.size());
+
+    EXPECT_EQ(split_at_statements(dir.write_file("empty.ttl", ""), 8).size(), 1);
+    EXPECT_THROW((void) split_at_statements(dir.path() / "missing.ttl", 8), std::runtime_error);
+}
+
+TEST(TurtleSplitterTest, ChunksOfWrittenTurtleParseBackToTheSameTriples) {
+    auto const triples = many_triples();
+
+    std::ostringstream out;
+    writer::TurtleWriter writer{out, writer::TurtleWriter::Options{.learning_triples = 100}};
+    for (auto const &[s, p, o] : triples) {
+        writer.write(s, p, o);
+    }
+    writer.finish();
+
+    TempDirectory const dir;
+    auto const path = dir.write_file("data.ttl", out.str());
+
+    std::multiset<Triple> const expected{triples.begin(), triples.end()};
+    for (size_t const n : {1UL, 3UL, 16UL}) {
+        auto const chunks = split_at_statements(path, n);
+        expect_contiguous_statements(chunks, read_file(path));
+        EXPECT_EQ(parse_chunks(chunks), expected) << "n " << n;
+    }
+}
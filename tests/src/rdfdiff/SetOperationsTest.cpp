@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <SetOperations.hpp>
+
+#include <TempDirectory.hpp>
+
+using namespace rdf4cpp::rdftools::diff;
+using rdf4cpp::rdftools::tests::TempDirectory;
+
+namespace {
+
+    std::string triple(size_t const i) {
+        return "<http://example.org/s" + std::to_string(i % 17) + "> <http://example.org/p" + std::to_string(i % 3) +
+               "> <http://example.org/o" + std::to_string(i) + "> .";
+    }
+
+    /**
+     * N-Triples file with the triples i for i in [begin, end). Every triple is written twice.
+     */
+    std::filesystem::path write_dataset(TempDirectory const &dir, std::string_view const name, size_t const begin, size_t const end) {
+        std::string content;
+        for (size_t i = begin; i < end; ++i) {
+            content += triple(i) + "\n" + triple(i) + "\n";
+        }
+        return dir.write_file(name, content);
+    }
+
+    std::vector<std::string> expected_triples(std::vector<size_t> const &ids) {
+        std::vector<std::string> triples;
+        for (auto const i : ids) {
+            triples.push_back(triple(i));
+        }
+        std::ranges::sort(triples);
+        return triples;
+    }
+
+    std::vector<std::string> sorted_lines(std::string const &text) {
+        std::vector<std::string> lines;
+        std::istringstream in{text};
+        for (std::string line; std::getline(in, line);) {
+            lines.push_back(line);
+        }
+        std::ranges::sort(lines);
+        return lines;
+    }
+
+    std::vector<size_t> range(size_t const begin, size_t const end) {
+        std::vector<size_t> ids;
+        for (auto i = begin; i < end; ++i) {
+            ids.push_back(i);
+        }
+        return ids;
+    }
+
+    /**
+     * Runs the operation in all modes, i.e. hash and exact, with one and several threads, with and without partitioning,
+     * and checks that each gives the expected triples once.
+     */
+    void expect_result(std::vector<Dataset> const &datasets, Operation const operation, std::vector<size_t> const &expected_ids) {
+        auto const expected = expected_triples(expected_ids);
+        TempDirectory const spill_dir;
+
+        for (bool const exact : {false, true}) {
+            for (size_t const threads : {1UL, 4UL}) {
+                Options const options{.operation = operation, .exact = exact, .threads = threads};
+
+                std::ostringstream out;
+                EXPECT_EQ(run(datasets, out, options), expected.size());
+                EXPECT_EQ(sorted_lines(out.str()), expected) << "exact " << exact << " threads " << threads;
+
+                std::ostringstream partitioned_out;
+                uint64_t partitioned_count = 0;
+                for (auto const &partition_datasets : partition(datasets, spill_dir.path(), 3, options)) {
+                    partitioned_count += run(partition_datasets, partitioned_out, options);
+                }
+                EXPECT_EQ(partitioned_count, expected.size());
+                EXPECT_EQ(sorted_lines(partitioned_out.str()), expected) << "partitioned, exact " << exact << " threads " << threads;
+            }
+        }
+    }
+
+}  // namespace
+
+TEST(SetOperationsTest, Union) {
+    TempDirectory const dir;
+    auto const a = write_dataset(dir, "a.nt", 0, 300);
+    auto const b = write_dataset(dir, "b.nt", 200, 500);
+    auto const c = write_dataset(dir, "c.nt", 450, 600);
+
+    expect_result({{a}, {b}, {c}}, Operation::Union, range(0, 600));
+}
+
+TEST(SetOperationsTest, Intersection) {
+    TempDirectory const dir;
+    auto const a = write_dataset(dir, "a.nt", 0, 300);
+    auto const b = write_dataset(dir, "b.nt", 200, 1000);
+    auto const c = write_dataset(dir, "c.nt", 250, 280);
+
+    expect_result({{a}, {b}}, Operation::Intersection, range(200, 300));
+    expect_result({{a}, {b}, {c}}, Operation::Intersection, range(250, 280));
+}
+
+TEST(SetOperationsTest, DifferenceWithSmallMinuend) {
+    TempDirectory const dir;
+    auto const a = write_dataset(dir, "a.nt", 0, 100);
+    auto const b = write_dataset(dir, "b.nt", 50, 1000);
+
+    expect_result({{a}, {b}}, Operation::Difference, range(0, 50));
+}
+
+TEST(SetOperationsTest, DifferenceWithLargeMinuend) {
+    TempDirectory const dir;
+    auto const a = write_dataset(dir, "a.nt", 0, 1000);
+    auto const b = write_dataset(dir, "b.nt", 100, 200);
+    auto const c = write_dataset(dir, "c.nt", 900, 1100);
+
+    auto expected = range(0, 100);
+    auto const rest = range(200, 900);
+    expected.insert(expected.end(), rest.begin(), rest.end());
+    expect_result({{a}, {b}, {c}}, Operation::Difference, expected);
+}
+
+TEST(SetOperationsTest, DatasetOfSeveralFiles) {
+    TempDirectory const dir;
+    auto const a1 = write_dataset(dir, "a1.nt", 0, 100);
+    auto const a2 = write_dataset(dir, "a2.nt", 100, 200);
+    auto const b = write_dataset(dir, "b.nt", 150, 250);
+
+    expect_result({{a1, a2}, {b}}, Operation::Intersection, range(150, 200));
+}
+
+TEST(SetOperationsTest, MissingFileFails) {
+    TempDirectory const dir;
+    auto const a = write_dataset(dir, "a.nt", 0, 100);
+    auto const missing = dir.path() / "missing.nt";
+
+    for (auto const operation : {Operation::Union, Operation::Intersection, Operation::Difference}) {
+        std::ostringstream out;
+        EXPECT_THROW((void) run({{a}, {missing}}, out, Options{.operation = operation}), std::runtime_error);
+        EXPECT_THROW((void) run({{missing}, {a}}, out, Options{.operation = operation}), std::runtime_error);
+    }
+
+    TempDirectory const spill_dir;
+    EXPECT_THROW((void) partition({{a}, {missing}}, spill_dir.path(), 3, Options{}), std::runtime_error);
+    EXPECT_TRUE(std::filesystem::is_empty(spill_dir.path()));
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <parser/IStreamQuadIterator.hpp>
+#include <writer/TurtleWriter.hpp>
+
+using namespace rdf4cpp::rdftools;
+using writer::TurtleWriter;
+
+namespace {
+
+    using Triple = std::array<std::string, 3>;
+
+    std::string write_turtle(std::vector<Triple> const &triples, TurtleWriter::Options const options,
+                             std::vector<std::array<std::string, 2>> const &prefixes = {}) {
+        std::ostringstream out;
+        TurtleWriter writer{out, options};
+        for (auto const &[name, namespace_iri] : prefixes) {
+            writer.declare_prefix(name, namespace_iri);
+        }
+        for (auto const &[s, p, o] : triples) {
+            writer.write(s, p, o);
+        }
+        writer.finish();
+        return out.str();
+    }
+
+    std::multiset<Triple> parse_turtle(std::string const &turtle) {
+        std::istringstream in{turtle};
+        std::multiset<Triple> triples;
+        for (parser::IStreamQuadIterator qit{in}; qit != parser::IStreamQuadIterator{}; ++qit) {
+            EXPECT_TRUE(qit->has_value()) << qit->error().message;
+            if (qit->has_value()) {
+                auto const &quad = qit->value();
+                triples.insert(Triple{std::string{quad[1].view()}, std::string{quad[2].view()}, std::string{quad[3].view()}});
+            }
+        }
+        return triples;
+    }
+
+    std::vector<Triple> const example_triples{
+            {"<http://example.org/a>", "<http://www.w3.org/1999/02/22-rdf-syntax-ns#type>", "<http://example.org/C>"},
+            {"<http://example.org/a>", "<http://example.org/p>", "\"42\"^^<http://www.w3.org/2001/XMLSchema#integer>"},
+            {"<http://example.org/a>", "<http://example.org/p>", "\"x\"@en"},
+            {"<http://example.org/b>", "<http://other.org/q>", "_:b1"},
+            {"<http://example.org/b>", "<http://example.org/p>", "\"true\"^^<http://www.w3.org/2001/XMLSchema#boolean>"},
+            {"<http://example.org/c/d>", "<http://example.org/p>", "\"1.5\"^^<http://www.w3.org/2001/XMLSchema#decimal>"},
+            {"_:b1", "<http://example.org/p>", "\"line\\nbreak \\\"quoted\\\"\""},
+    };
+
+}  // namespace
+
+TEST(TurtleWriterTest, AbbreviatesAndGroups) {
+    auto const turtle = write_turtle(example_triples, TurtleWriter::Options{.learning_triples = 0}, {{"ex", "http://example.org/"}});
+
+    EXPECT_EQ(turtle, "@prefix ex: <http://example.org/> .\n"
+                      "\n"
+                      "ex:a a ex:C ;\n"
+                      "    ex:p 42 ,\n"
+                      "        \"x\"@en .\n"
+                      "ex:b <http://other.org/q> _:b1 ;\n"
+                      "    ex:p true .\n"
+                      "<http://example.org/c/d> ex:p 1.5 .\n"
+                      "_:b1 ex:p \"line\\nbreak \\\"quoted\\\"\" .\n");
+}
+
+TEST(TurtleWriterTest, LearnsFrequentNamespaces) {
+    std::vector<Triple> triples;
+    for (size_t i = 0; i < 100; ++i) {
+        triples.push_back({"<http://learned.org/ns/s" + std::to_string(i) + ">", "<http://learned.org/ns/p>", "<http://learned.org/ns/o>"});
+    }
+
+    auto const turtle = write_turtle(triples, TurtleWriter::Options{.learning_triples = 50});
+    EXPECT_TRUE(turtle.starts_with("@prefix ns1: <http://learned.org/ns/> .\n")) << turtle;
+    EXPECT_EQ(turtle.find("<http://learned.org/ns/"), turtle.rfind("<http://learned.org/ns/")) << turtle;
+    EXPECT_NE(turtle.find("ns1:s99 ns1:p ns1:o .\n"), std::string::npos) << turtle;
+}
+
+TEST(TurtleWriterTest, WithoutTriplesWritesOnlyPrefixes) {
+    EXPECT_EQ(write_turtle({}, TurtleWriter::Options{.learning_triples = 0}, {{"ex", "http://example.org/"}}),
+              "@prefix ex: <http://example.org/> .\n\n");
+}
+
+TEST(TurtleWriterTest, ParsesBackToTheSameTriples) {
+    for (size_t const learning_triples : {0UL, 3UL, 10'000UL}) {
+        auto const turtle = write_turtle(example_triples, TurtleWriter::Options{.learning_triples = learning_triples},
+                                         {{"ex", "http://example.org/"}});
+        EXPECT_EQ(parse_turtle(turtle), (std::multiset<Triple>{example_triples.begin(), example_triples.end()})) << turtle;
+    }
+}